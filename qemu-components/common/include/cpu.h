@@ -57,6 +57,7 @@ protected:
     std::shared_ptr<gs::tlm_quantumkeeper_extended> m_qk;
     std::atomic<bool> m_finished = false;
     std::atomic<bool> m_started = false;
+    std::atomic<bool> m_deadline_kick{ false }; // next kick comes from our deadline timer
     enum { none, start_reset, hold_reset, finish_reset } m_resetting = none;
     gs::async_event m_start_reset_done_ev;
 
@@ -194,6 +195,10 @@ protected:
     void kick_cb()
     {
         SCP_TRACE(())("QEMU deadline KICK callback");
+        if (!m_deadline_kick.exchange(false)) {
+            /* Not our own deadline timer: an interrupt or another external event */
+            m_qk->record_interaction(gs::QkInteraction::IRQ);
+        }
         if (m_coroutines) {
             if (!m_finished) m_qemu_kick_ev.async_notify();
         } else {
@@ -211,6 +216,7 @@ protected:
     {
         SCP_TRACE(())("QEMU deadline timer callback");
         // All syncing will be done in end_of_loop_cb
+        m_deadline_kick = true;
         m_cpu.kick();
         // Rearm timer for next time ....
         if (!m_finished) {
@@ -392,6 +398,8 @@ protected:
 
 public:
     cci::cci_param<unsigned int> p_gdb_port;
+    cci::cci_param<bool> p_qemu_mr_bypass;
+    cci::cci_param<bool> p_dmi_alias_merge;
 
     /* The default memory socket. Mapped to the default CPU address space in QEMU */
     QemuInitiatorSocket<> socket;
@@ -405,6 +413,12 @@ public:
         , m_qemu_kick_ev(false)
         , m_signaled(false)
         , p_gdb_port("gdb_port", 0, "Wait for gdb connection on TCP port <gdb_port>")
+        , p_qemu_mr_bypass("qemu_mr_bypass", false,
+                           "At start of simulation, map the targets which are QEMU devices of the same instance "
+                           "directly in the CPU address space")
+        , p_dmi_alias_merge("dmi_alias_merge", false,
+                            "Merge DMI regions contiguous both in the address space and in host memory, to "
+                            "support targets handing out many small DMI regions")
         , socket("mem", *this, inst)
     {
         using namespace std::placeholders;
@@ -526,6 +540,7 @@ public:
             m_sc_thread = sc_core::sc_spawn(std::bind(&QemuCpu::mainloop_thread_coroutine, this));
         }
 
+        socket.set_dmi_merge(p_dmi_alias_merge);
         socket.init(m_dev, "memory");
 
         m_cpu.set_soft_stopped(true);
@@ -607,6 +622,14 @@ public:
         m_quantum_ns = int64_t(tlm_utils::tlm_quantumkeeper::get_global_quantum().to_seconds() * 1e9);
 
         QemuDevice::start_of_simulation();
+
+        if (p_qemu_mr_bypass) {
+            m_inst.get().lock_iothread();
+            socket.map_qemu_mr_targets();
+            m_inst.get().unlock_iothread();
+            SCP_INFO(())("{} QEMU device region(s) mapped directly", socket.get_qemu_mr_bypass_count());
+        }
+
         if (m_inst.get_tcg_mode() == QemuInstance::TCG_SINGLE) {
             if (m_inst.can_run()) {
                 m_qk->start();
@@ -662,6 +685,10 @@ public:
     {
         /* Signal the other end we are a CPU */
         payload.set_extension(&m_cpu_hint_ext);
+        /* DMI probes use TLM_IGNORE_COMMAND, only the actual accesses count */
+        if (payload.get_command() != tlm::TLM_IGNORE_COMMAND) {
+            m_qk->record_interaction(gs::QkInteraction::MMIO);
+        }
     }
 
     virtual void initiator_tidy_tlm_payload(TlmPayload& payload) override { payload.clear_extension(&m_cpu_hint_ext); }
@@ -710,7 +737,9 @@ public:
     /* expose async run interface for DMI invalidation */
     virtual void initiator_async_run(qemu::Cpu::AsyncJobFn job) override
     {
-        if (!m_finished) m_cpu.async_run(make_tracked_async_job(std::move(job)));
+        if (m_finished) return;
+        m_qk->record_interaction(gs::QkInteraction::DMI_INVALIDATE);
+        m_cpu.async_run(make_tracked_async_job(std::move(job)));
     }
 };
 
@@ -14,6 +14,7 @@
 #include <limits>
 #include <cassert>
 #include <memory>
+#include <iterator>
 
 #include <tlm>
 
@@ -85,6 +86,7 @@ public:
         QemuContainer m_container;
         qemu::MemoryRegion m_mr;
         uint64_t m_size;
+        int m_fd = -1;
 
         bool m_retiring = false;
 
@@ -105,6 +107,7 @@ public:
             , m_container(inst.object_new_unparented<QemuContainer>())
             , m_mr(inst.object_new_unparented<qemu::MemoryRegion>())
             , m_size(size_from_tlm_dmi(info))
+            , m_fd(fd)
         {
             //          This will parent the objects
             m_mr.init_ram_ptr(m_container, "dmi", m_size, m_ptr, fd);
@@ -122,6 +125,7 @@ public:
         Key get_key() const { return reinterpret_cast<Key>(m_ptr); }
         Key get_end() const { return get_key() + (m_size - 1); }
         unsigned char* get_ptr() const { return m_ptr; }
+        int get_fd() const { return m_fd; }
 
         static Key key_from_tlm_dmi(const tlm::tlm_dmi& info) { return reinterpret_cast<Key>(info.get_dmi_ptr()); }
 
@@ -223,35 +227,78 @@ protected:
      */
     DmiRegionMap m_regions;
 
+    /**
+     * @brief Address ranges already resolved through get_direct_mem_ptr, for
+     * each initiator view of the address space, indexed by start address.
+     * Ranges in a view never overlap. They are either DMI regions currently
+     * aliased by the initiator, or ranges in which DMI was authoritatively
+     * refused (address map holes, targets describing the refused range). A
+     * refusal without a range, e.g. lock contention, is never recorded.
+     */
+    using TopologyMap = std::map<uint64_t, tlm::tlm_dmi>;
+    std::map<const void*, TopologyMap> m_topology;
+    std::mutex m_topology_mutex;
+
 public:
     /**
      * @brief This regions are added as subregions of the manager root memory
      * region container. They can overlap, hence we use the priority mechanism
      * provided by QEMU.
+     *
+     * @details If `merge` is true, the new region is fused with the anonymous
+     * (not fd backed) regions directly adjacent to it in host memory, so that
+     * many small contiguous DMI windows end up as a single QEMU RAM region.
+     * Aliases are built on the root container at the host pointer offset, so
+     * existing aliases are not affected by the replacement, as long as the
+     * caller holds a memory region transaction across it.
      */
-    void get_region(const tlm::tlm_dmi& info, int fd = -1)
+    void get_region(const tlm::tlm_dmi& info, int fd = -1, bool merge = false)
     {
         DmiRegion::Key start = DmiRegion::key_from_tlm_dmi(info);
         uint64_t size = (info.get_end_address() - info.get_start_address()) + 1;
-
-        tlm::tlm_dmi dmi;
-        dmi.set_start_address(info.get_start_address());
-        dmi.set_end_address(info.get_end_address());
-        dmi.set_dmi_ptr(info.get_dmi_ptr());
+        DmiRegion::Key end = start + (size - 1);
 
         std::lock_guard<std::mutex> lock(m_mutex);
 
-        auto existing_it = m_regions.find(start);
+        auto existing_it = m_regions.upper_bound(start);
+        if (existing_it != m_regions.begin()) {
+            auto prev = std::prev(existing_it);
+            if (prev->second.get_end() >= end) {
+                return; // Already covered by an existing region
+            }
+        }
+
+        existing_it = m_regions.find(start);
         if (existing_it != m_regions.end()) {
-            if (existing_it->second.get_size() != size) {
-                SCP_INFO("DMI.Libqbox")
-                ("Overlapping DMI regions old size {:x} new size {:x}!", existing_it->second.get_size(), size);
-                m_root.del_subregion(existing_it->second.get_mut_mr());
-                m_regions.erase(existing_it);
-            } else {
-                return; // Identical region exists
+            SCP_INFO("DMI.Libqbox")
+            ("Overlapping DMI regions old size {:x} new size {:x}!", existing_it->second.get_size(), size);
+            m_root.del_subregion(existing_it->second.get_mut_mr());
+            m_regions.erase(existing_it);
+        }
+
+        if (merge && fd < 0) {
+            auto next = m_regions.upper_bound(start);
+            if (next != m_regions.begin()) {
+                auto prev = std::prev(next);
+                if (prev->second.get_fd() < 0 && prev->second.get_end() + 1 == start) {
+                    start = prev->first;
+                    m_root.del_subregion(prev->second.get_mut_mr());
+                    m_regions.erase(prev);
+                }
+            }
+            next = m_regions.find(end + 1);
+            if (next != m_regions.end() && next->second.get_fd() < 0) {
+                end = next->second.get_end();
+                m_root.del_subregion(next->second.get_mut_mr());
+                m_regions.erase(next);
             }
         }
+
+        tlm::tlm_dmi dmi;
+        dmi.set_start_address(0);
+        dmi.set_end_address(end - start);
+        dmi.set_dmi_ptr(reinterpret_cast<unsigned char*>(start));
+
         DmiRegion region = DmiRegion(dmi, 0, m_inst, fd);
         m_root.add_subregion(region.get_mut_mr(), region.get_key());
 
@@ -277,6 +324,78 @@ public:
         m_root.init(m_root_container, "dmi-manager", std::numeric_limits<uint64_t>::max());
     }
 
+    /**
+     * @brief Look up the range containing `addr` in the topology cache of
+     * `view`.
+     *
+     * @returns true and fill `dmi` if the range is known.
+     */
+    bool topology_lookup(const void* view, uint64_t addr, tlm::tlm_dmi& dmi)
+    {
+        std::lock_guard<std::mutex> lock(m_topology_mutex);
+
+        auto vit = m_topology.find(view);
+        if (vit == m_topology.end()) {
+            return false;
+        }
+
+        TopologyMap& map = vit->second;
+        auto it = map.upper_bound(addr);
+        if (it == map.begin()) {
+            return false;
+        }
+        --it;
+        if (it->second.get_end_address() < addr) {
+            return false;
+        }
+        dmi = it->second;
+        return true;
+    }
+
+    /**
+     * @brief Record a resolved range in the topology cache of `view`,
+     * replacing any range it overlaps.
+     */
+    void topology_insert(const void* view, const tlm::tlm_dmi& dmi)
+    {
+        std::lock_guard<std::mutex> lock(m_topology_mutex);
+
+        topology_erase_locked(m_topology[view], dmi.get_start_address(), dmi.get_end_address());
+        m_topology[view][dmi.get_start_address()] = dmi;
+    }
+
+    /**
+     * @brief Forget every range of `view` overlapping [start, end]
+     */
+    void topology_invalidate(const void* view, uint64_t start, uint64_t end)
+    {
+        std::lock_guard<std::mutex> lock(m_topology_mutex);
+
+        auto vit = m_topology.find(view);
+        if (vit != m_topology.end()) {
+            topology_erase_locked(vit->second, start, end);
+        }
+    }
+
+    void topology_clear(const void* view)
+    {
+        std::lock_guard<std::mutex> lock(m_topology_mutex);
+        m_topology.erase(view);
+    }
+
+private:
+    static void topology_erase_locked(TopologyMap& map, uint64_t start, uint64_t end)
+    {
+        auto it = map.upper_bound(start);
+        if (it != map.begin() && std::prev(it)->second.get_end_address() >= start) {
+            --it;
+        }
+        while (it != map.end() && it->first <= end) {
+            it = map.erase(it);
+        }
+    }
+
+public:
     /**
      * @brief Create a new alias for the DMI region designated by `info`
      */
@@ -285,5 +404,19 @@ public:
         get_region(info, fd);
         return std::make_shared<DmiRegionAlias>(m_root, info, m_inst);
     }
+
+    /**
+     * @brief Create an alias for `merged`, a range made of existing aliases
+     * and of the new DMI region `info` which are contiguous both in the
+     * initiator address space and in host memory.
+     *
+     * @note The RAM regions backing them are replaced: call it within a memory
+     * region transaction.
+     */
+    DmiRegionAlias::Ptr get_merged_region_alias(const tlm::tlm_dmi& info, const tlm::tlm_dmi& merged, int fd = -1)
+    {
+        get_region(info, fd, true);
+        return std::make_shared<DmiRegionAlias>(m_root, merged, m_inst);
+    }
 };
 #endif
@@ -97,6 +97,23 @@ private:
 
     LibraryLoaderIface::LibraryIfacePtr m_lib;
 
+    bool m_mr_transaction_resolved = false;
+    void (*m_mr_transaction_begin)() = nullptr;
+    void (*m_mr_transaction_commit)() = nullptr;
+
+    void resolve_mr_transaction();
+
+    /* QEMU functions giving access to the RAM of the memory regions, not part
+     * of the libqemu exports. Resolved once, in init(). */
+    uint64_t (*m_mr_get_ram_addr)(QemuMemoryRegion*) = nullptr;
+    void* (*m_mr_get_ram_ptr)(QemuMemoryRegion*) = nullptr;
+    void* (*m_as_get_flatview)(QemuAddressSpace*) = nullptr;
+    void (*m_flatview_unref)(void*) = nullptr;
+    QemuMemoryRegion* (*m_flatview_translate)(void*, uint64_t, uint64_t*, uint64_t*, bool, ::MemTxAttrs) = nullptr;
+    bool (*m_iothread_locked)() = nullptr;
+
+    void resolve_ram_access();
+
     QemuObject* object_new_unparented(const char* type_name);
     QemuObject* object_new_internal(const char* type_name, const char* id);
 
@@ -119,6 +136,10 @@ public:
     void init();
     bool is_inited() const { return m_lib != nullptr; }
 
+    /* Look up a symbol of the loaded library which is not part of the libqemu
+     * exports. Returns nullptr if it does not exist. */
+    void* get_optional_symbol(const char* name);
+
     /* QEMU GDB stub
      * @port: port the gdb server will be listening on. (ex: "tcp::1234") */
     void start_gdb_server(std::string port);
@@ -128,8 +149,29 @@ public:
     void lock_iothread();
     void unlock_iothread();
 
+    /* Whether the calling thread holds the iothread lock. Assumed not to if
+     * the library does not tell. */
+    bool iothread_locked();
+
+    /* Host pointer to the RAM block of mr, nullptr if it has none or the
+     * library does not provide the needed functions. Must be called with the
+     * iothread lock held. */
+    void* memory_region_get_ram_ptr(QemuMemoryRegion* mr);
+
+    /* Resolve addr through the flatview of as. If it falls in a RAM backed
+     * section, return its host pointer and clamp len to the end of that
+     * section, return nullptr otherwise. Must be called with the iothread
+     * lock held. */
+    void* address_space_translate_ram(QemuAddressSpace* as, uint64_t addr, uint64_t& len);
+
     RcuReadLock rcu_read_lock_new();
 
+    /* Group memory topology updates so that QEMU rebuilds the flatviews only
+     * once, on the outermost commit. No-ops if the library does not provide
+     * them. Must be called with the iothread lock held. */
+    void memory_region_transaction_begin();
+    void memory_region_transaction_commit();
+
     void finish_qemu_init();
     Bus sysbus_get_default();
 
@@ -414,6 +456,12 @@ public:
 
     void set_ops(const MemoryRegionOpsPtr ops);
 
+    /* Host pointer to the RAM block of this region, or nullptr if it has none
+     * (or the library does not provide the needed symbols). A ROM device has
+     * a RAM block whatever its mode, this does not tell whether QEMU reads it
+     * directly. */
+    void* get_ram_ptr();
+
     bool operator<(const MemoryRegion& mr) const { return m_obj < mr.m_obj; }
 };
 
@@ -442,6 +490,10 @@ public:
     MemTxResult read(uint64_t addr, void* data, size_t size, MemTxAttrs attrs);
     MemTxResult write(uint64_t addr, const void* data, size_t size, MemTxAttrs attrs);
 
+    /* Host pointer of addr if it is in a RAM backed section of the address
+     * space, len is then clamped to the end of that section. nullptr otherwise. */
+    void* get_ram_ptr(uint64_t addr, uint64_t& len);
+
     void update_topology();
 };
 
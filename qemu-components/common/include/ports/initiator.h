@@ -13,6 +13,9 @@
 #include <limits>
 #include <cassert>
 #include <cinttypes>
+#include <algorithm>
+#include <chrono>
+#include <vector>
 
 #include <tlm>
 
@@ -96,6 +99,28 @@ protected:
     };
     m_mem_obj* m_r = nullptr;
 
+    /*
+     * A memory region of this QEMU instance, reached through a SystemC
+     * target bridge, and aliased directly in the root MR so that accesses
+     * to it stay inside QEMU.
+     */
+    struct QemuMrBypass {
+        uint64_t start;
+        uint64_t size;
+        qemu::MemoryRegion alias;
+        bool at_elaboration;
+        /* accesses that still went through SystemC once the bypass existed */
+        uint64_t slow_path_hits = 0;
+    };
+    std::map<uint64_t, QemuMrBypass> m_mr_bypasses;
+
+    /* Merge host-contiguous adjacent DMI aliases into a single one */
+    bool m_dmi_merge = false;
+
+    /* qemu_map ranges resolved from the DMI manager topology cache / through get_direct_mem_ptr */
+    uint64_t m_map_cache_hits = 0;
+    uint64_t m_map_cache_misses = 0;
+
     // we use an ordered map to find and combine elements
     std::map<DmiRegionAliasKey, DmiRegionAlias::Ptr> m_dmi_aliases;
     using AliasesIterator = std::map<DmiRegionAliasKey, DmiRegionAlias::Ptr>::iterator;
@@ -133,12 +158,34 @@ protected:
         m_initiator.initiator_customize_tlm_payload(trans);
     }
 
+    /*
+     * Every alias addition or removal changes the root MR topology, QEMU then
+     * regenerates the flatview of the address space. Keep track of the time
+     * it takes against the number of aliases.
+     */
+    struct DmiAliasStats {
+        uint64_t topology_updates = 0;
+        uint64_t merges = 0;
+        size_t peak_aliases = 0;
+        std::chrono::nanoseconds update_time{ 0 };
+    };
+    DmiAliasStats m_dmi_stats;
+
+    void account_topology_update(std::chrono::steady_clock::time_point start)
+    {
+        m_dmi_stats.topology_updates++;
+        m_dmi_stats.update_time += std::chrono::steady_clock::now() - start;
+        m_dmi_stats.peak_aliases = std::max(m_dmi_stats.peak_aliases, m_dmi_aliases.size());
+    }
+
     void add_dmi_mr_alias(DmiRegionAlias::Ptr alias)
     {
         SCP_INFO(()) << "Adding " << *alias;
+        auto t0 = std::chrono::steady_clock::now();
         qemu::MemoryRegion alias_mr = alias->get_alias_mr();
         m_r->m_root->add_subregion(alias_mr, alias->get_start());
         alias->set_installed();
+        account_topology_update(t0);
     }
 
     void del_dmi_mr_alias(const DmiRegionAlias::Ptr alias)
@@ -147,7 +194,49 @@ protected:
             return;
         }
         SCP_INFO(()) << "Removing " << *alias;
+        auto t0 = std::chrono::steady_clock::now();
         m_r->m_root->del_subregion(alias->get_alias_mr());
+        account_topology_update(t0);
+    }
+
+    /*
+     * Look for installed aliases directly preceding and following `dmi_data`
+     * both in the address space and in host memory, and extend `merged` over
+     * them. Returns the iterators of the aliases to replace.
+     */
+    std::vector<AliasesIterator> find_mergeable_aliases(const tlm::tlm_dmi& dmi_data, tlm::tlm_dmi& merged)
+    {
+        std::vector<AliasesIterator> ret;
+        uint64_t start = dmi_data.get_start_address();
+        uint64_t end = dmi_data.get_end_address();
+
+        merged = dmi_data;
+
+        auto next = m_dmi_aliases.lower_bound(start);
+        if (next != m_dmi_aliases.begin()) {
+            auto prev = std::prev(next);
+            const DmiRegionAlias::Ptr& p = prev->second;
+            if (p->is_installed() && p->get_end() + 1 == start &&
+                p->get_dmi_ptr() + p->get_size() == dmi_data.get_dmi_ptr()) {
+                merged.set_start_address(p->get_start());
+                merged.set_dmi_ptr(p->get_dmi_ptr());
+                ret.push_back(prev);
+            }
+        }
+
+        if (end != std::numeric_limits<uint64_t>::max()) {
+            next = m_dmi_aliases.find(end + 1);
+            if (next != m_dmi_aliases.end()) {
+                const DmiRegionAlias::Ptr& n = next->second;
+                if (n->is_installed() &&
+                    dmi_data.get_dmi_ptr() + (end - start) + 1 == n->get_dmi_ptr()) {
+                    merged.set_end_address(n->get_end());
+                    ret.push_back(next);
+                }
+            }
+        }
+
+        return ret;
     }
 
     /**
@@ -334,11 +423,18 @@ protected:
      * @note Needs to be called with iothread locked as it will be doing several
      * updates and we dont want multiple DMI's
      *
+     * @param authoritative if not null, set to whether the returned range can
+     * be trusted until the next invalidation: a DMI granted, or refused for a
+     * known range (a hole in the address map, or a target describing where it
+     * does not allow DMI). A refusal without a range may be transient, e.g. a
+     * router busy invalidating.
+     *
      * @returns The DMI descriptor for the corresponding DMI region - this is used to help construct memory maps only.
      */
-    tlm::tlm_dmi check_dmi_hint_locked(TlmPayload& trans)
+    tlm::tlm_dmi check_dmi_hint_locked(TlmPayload& trans, bool* authoritative = nullptr)
     {
         assert(trans.is_dmi_allowed());
+        if (authoritative) *authoritative = false;
         tlm::tlm_dmi dmi_data;
         int shm_fd = -1;
         auto addr = trans.get_address();
@@ -375,20 +471,27 @@ protected:
         trans.clear_extension(&u_dmi);
         if (!dmi_valid) {
             SCP_INFO(())("No DMI available for {:x}", trans.get_address());
+            /* The target described the range it refuses, rather than leaving the reply empty */
+            bool refused_range = !dmi_range_unbounded(dmi_data);
             /* this is used by the map function below
              * - a better plan may be to tag memories to be mapped so we dont need this
              */
             if (u_dmi.has_dmi(gs::tlm_dmi_ex::dmi_mapped)) {
                 tlm::tlm_dmi first_map = u_dmi.get_first(gs::tlm_dmi_ex::dmi_mapped);
+                if (authoritative) *authoritative = refused_range;
                 return first_map;
             }
             if (u_dmi.has_dmi(gs::tlm_dmi_ex::dmi_nomap)) {
                 tlm::tlm_dmi first_nomap = u_dmi.get_first(gs::tlm_dmi_ex::dmi_nomap);
+                if (authoritative) *authoritative = true;
                 return first_nomap;
             }
+            if (authoritative) *authoritative = refused_range;
             return dmi_data;
         }
 
+        if (authoritative) *authoritative = true;
+
         /*
          * This is the 'special' case of IOMMU's which require an IOMMU memory region setup
          * The IOMMU will be constructed here, but not populated - that will happen in the callback
@@ -484,23 +587,80 @@ protected:
         qemu::RcuReadLock rcu_read_lock = m_inst.get().rcu_read_lock_new();
 
         if (m_dmi_aliases.size() > MAX_MAP) {
-            SCP_FATAL(())("Too many DMI regions requested, consider using an IOMMU");
+            SCP_FATAL(())("Too many DMI regions requested, consider using an IOMMU{}",
+                          m_dmi_merge ? "" : " or enabling dmi_alias_merge");
         }
         uint64_t start = dmi_data.get_start_address();
         uint64_t end = dmi_data.get_end_address();
 
-        if (0 == m_dmi_aliases.count(start)) {
-            SCP_INFO(()) << "Adding DMI for range [0x" << std::hex << dmi_data.get_start_address() << "-0x" << std::hex
-                         << dmi_data.get_end_address() << "]";
+        auto covering = m_dmi_aliases.upper_bound(start);
+        if (covering != m_dmi_aliases.begin()) {
+            const DmiRegionAlias::Ptr& a = std::prev(covering)->second;
+            if (a->get_start() <= start && end <= a->get_end()) {
+                /* Possibly part of a bigger merged alias, report the whole of it */
+                SCP_INFO(())("Already have DMI for 0x{:x}", start);
+                dmi_data.set_start_address(a->get_start());
+                dmi_data.set_end_address(a->get_end());
+                dmi_data.set_dmi_ptr(a->get_dmi_ptr());
+                return dmi_data;
+            }
+        }
+
+        SCP_INFO(()) << "Adding DMI for range [0x" << std::hex << dmi_data.get_start_address() << "-0x" << std::hex
+                     << dmi_data.get_end_address() << "]";
 
+        tlm::tlm_dmi merged;
+        std::vector<AliasesIterator> neighbours;
+        if (m_dmi_merge && shm_fd < 0) {
+            neighbours = find_mergeable_aliases(dmi_data, merged);
+        }
+
+        if (neighbours.empty()) {
             DmiRegionAlias::Ptr alias = m_inst.get_dmi_manager().get_new_region_alias(dmi_data, shm_fd);
 
             m_dmi_aliases[start] = alias;
             add_dmi_mr_alias(m_dmi_aliases[start]);
-        } else {
-            SCP_INFO(())("Already have DMI for 0x{:x}", start);
+            return dmi_data;
         }
-        return dmi_data;
+
+        /*
+         * Replace the neighbours by a single alias covering them and the new
+         * region, in one topology update. The DMI manager swaps the RAM
+         * regions backing them in the shared root, this must be part of the
+         * same transaction: in between, the aliases of the other CPUs pointing
+         * into these regions would resolve to a hole.
+         */
+        SCP_INFO(())("Merging DMI range [0x{:x}-0x{:x}] into [0x{:x}-0x{:x}]", start, end,
+                     merged.get_start_address(), merged.get_end_address());
+
+        m_inst.get().memory_region_transaction_begin();
+        DmiRegionAlias::Ptr alias = m_inst.get_dmi_manager().get_merged_region_alias(dmi_data, merged);
+        for (auto it : neighbours) {
+            del_dmi_mr_alias(it->second);
+            m_dmi_aliases.erase(it);
+        }
+        m_dmi_aliases[merged.get_start_address()] = alias;
+        add_dmi_mr_alias(alias);
+        m_inst.get().memory_region_transaction_commit();
+
+        m_dmi_stats.merges += neighbours.size();
+        return merged;
+    }
+
+    void add_qemu_mr_bypass(qemu::MemoryRegion target_mr, uint64_t start, uint64_t mr_offset, uint64_t size,
+                            bool at_elaboration)
+    {
+        QemuMrBypass bypass;
+        bypass.start = start;
+        bypass.size = size;
+        bypass.at_elaboration = at_elaboration;
+        bypass.alias = m_inst.get().template object_new<qemu::MemoryRegion>();
+
+        SCP_INFO(())("Mapping QEMU MR directly at [0x{:x}-0x{:x}] (MR offset 0x{:x})", start, start + size - 1,
+                     mr_offset);
+        bypass.alias.init_alias(m_dev, "mr-alias", target_mr, mr_offset, size);
+        m_r->m_root->add_subregion(bypass.alias, start);
+        m_mr_bypasses.emplace(start, std::move(bypass));
     }
 
     void check_qemu_mr_hint(TlmPayload& trans)
@@ -522,10 +682,14 @@ protected:
 
         mapping_addr = trans.get_address() - ext->get_offset();
 
-        qemu::MemoryRegion mr(m_inst.get().template object_new<qemu::MemoryRegion>());
+        auto it = m_mr_bypasses.find(mapping_addr);
+        if (it != m_mr_bypasses.end()) {
+            /* Already aliased, this access raced with the alias installation */
+            it->second.slow_path_hits++;
+            return;
+        }
 
-        mr.init_alias(m_dev, "mr-alias", target_mr, 0, target_mr.get_size());
-        m_r->m_root->add_subregion(mr, mapping_addr);
+        add_qemu_mr_bypass(target_mr, mapping_addr, 0, target_mr.get_size(), false);
     }
 
     void do_regular_access(TlmPayload& trans)
@@ -660,9 +824,123 @@ public:
         m_dev = dev;
     }
 
+    /**
+     * @brief Alias the QEMU memory regions of this instance that are reachable
+     * through the bound SystemC targets directly in the root MR.
+     *
+     * @details The address map is walked region by region using DMI requests
+     * carrying an UnderlyingDMITlmExtension (to learn the decoded hole around
+     * each address) and an empty QemuMrHintTlmExtension, which a
+     * TlmTargetToQemuBridge fills with the memory region it wraps. Regions
+     * backed by a memory region of the same instance are then mapped as
+     * aliases, so that CPU accesses to them never leave QEMU.
+     *
+     * @note Must be called from the SystemC thread with the iothread locked,
+     * once the target devices are realized.
+     */
+    void map_qemu_mr_targets()
+    {
+        if (m_finished) return;
+
+        uint64_t addr = 0;
+        uint64_t tmp;
+
+        for (;;) {
+            TlmPayload trans;
+            gs::UnderlyingDMITlmExtension u_dmi;
+            QemuMrHintTlmExtension hint;
+            tlm::tlm_dmi dmi_data;
+
+            init_payload(trans, tlm::TLM_IGNORE_COMMAND, addr, &tmp, 0);
+            trans.set_extension(&u_dmi);
+            trans.set_extension(&hint);
+            bool dmi_valid = (*this)->get_direct_mem_ptr(trans, dmi_data);
+            trans.clear_extension(&hint);
+            trans.clear_extension(&u_dmi);
+            m_initiator.initiator_tidy_tlm_payload(trans);
+
+            /* The decoded region around addr is the intersection of the holes reported on the path */
+            uint64_t start = 0;
+            uint64_t end = std::numeric_limits<uint64_t>::max();
+            for (auto& d : u_dmi) {
+                if (d.type == gs::tlm_dmi_ex::dmi_mapped || d.type == gs::tlm_dmi_ex::dmi_nomap) {
+                    start = std::max<uint64_t>(start, d.get_start_address());
+                    end = std::min<uint64_t>(end, d.get_end_address());
+                }
+            }
+            if (dmi_valid) {
+                end = std::min<uint64_t>(end, dmi_data.get_end_address());
+            }
+
+            qemu::MemoryRegion target_mr(hint.get_mr());
+            if (target_mr.valid() && target_mr.get_inst_id() == m_dev.get_inst_id()) {
+                uint64_t mr_base = addr - hint.get_offset();
+                uint64_t mr_size = target_mr.get_size();
+
+                if (u_dmi.empty()) {
+                    /* Bound directly to the bridge, the whole MR is visible */
+                    start = mr_base;
+                    end = mr_base + mr_size - 1;
+                }
+                start = std::max(start, mr_base);
+                uint64_t mr_offset = start - mr_base;
+                if (mr_offset < mr_size && m_mr_bypasses.count(start) == 0) {
+                    uint64_t size = std::min(end - start + 1, mr_size - mr_offset);
+                    add_qemu_mr_bypass(target_mr, start, mr_offset, size, true);
+                }
+            } else if (u_dmi.empty() && !dmi_valid) {
+                SCP_DEBUG(())("No address map information available at 0x{:x}, stop probing", addr);
+                break;
+            }
+
+            if (end == std::numeric_limits<uint64_t>::max() || end < addr) {
+                break;
+            }
+            addr = end + 1;
+        }
+    }
+
+    /**
+     * @brief Merge DMI regions which are contiguous both in the address space
+     * and in host memory into a single alias (and a single QEMU RAM region).
+     * This keeps the number of QEMU sections low when a target hands out many
+     * small DMI windows. Set it before the simulation starts, or while the
+     * CPU is blocked in an access.
+     */
+    void set_dmi_merge(bool merge) { m_dmi_merge = merge; }
+
+    size_t get_dmi_alias_count() const { return m_dmi_aliases.size(); }
+
+    const DmiAliasStats& get_dmi_alias_stats() const { return m_dmi_stats; }
+
+    /**
+     * @brief Number of QEMU memory regions mapped directly in the root MR
+     */
+    size_t get_qemu_mr_bypass_count() const { return m_mr_bypasses.size(); }
+
     void end_of_simulation()
     {
         m_finished = true;
+
+        SCP_INFO(())
+        ("Memory map: {} range(s) resolved from the DMI topology cache, {} through get_direct_mem_ptr",
+         m_map_cache_hits, m_map_cache_misses);
+
+        if (m_dmi_stats.topology_updates) {
+            SCP_INFO(())
+            ("DMI aliases: {} topology update(s), {} merge(s), peak {} alias(es), {:.1f} us per update",
+             m_dmi_stats.topology_updates, m_dmi_stats.merges, m_dmi_stats.peak_aliases,
+             std::chrono::duration<double, std::micro>(m_dmi_stats.update_time).count() /
+                 m_dmi_stats.topology_updates);
+        }
+
+        for (auto& b : m_mr_bypasses) {
+            const QemuMrBypass& bypass = b.second;
+            SCP_INFO(())
+            ("QEMU MR bypass [0x{:x}-0x{:x}] mapped at {}, {} access(es) through SystemC", bypass.start,
+             bypass.start + bypass.size - 1, bypass.at_elaboration ? "elaboration" : "first access",
+             bypass.slow_path_hits);
+        }
     }
 
     ~QemuInitiatorSocket()
@@ -681,37 +959,90 @@ public:
         //        dmimgr_unlock();
     }
 
+    /* The default range of a tlm_dmi, i.e. a reply carrying no information */
+    static bool dmi_range_unbounded(const tlm::tlm_dmi& dmi_data)
+    {
+        return dmi_data.get_start_address() == 0 &&
+               dmi_data.get_end_address() == std::numeric_limits<sc_dt::uint64>::max();
+    }
+
+    /*
+     * An authoritative range returned by check_dmi_hint_locked can be reused
+     * for the next mappings unless it is unbounded or belongs to an IOMMU
+     * region, which has its own translation cache.
+     */
+    bool dmi_range_cacheable(const tlm::tlm_dmi& dmi_data)
+    {
+        if (dmi_range_unbounded(dmi_data)) {
+            return false;
+        }
+        for (auto& m : m_mmio_mrs) {
+            if (m.first <= dmi_data.get_end_address() &&
+                dmi_data.get_start_address() <= m.first + m.second->get_size() - 1) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     void qemu_map(qemu::MemoryListener& listener, uint64_t addr, uint64_t len)
     {
-        // this function is relatively expensive, and called a lot, it should be done a different way and removed.
         if (m_finished) return;
 
         SCP_DEBUG(()) << "Mapping request for address [0x" << std::hex << addr << "-0x" << addr + len - 1 << "]";
 
+        QemuInstanceDmiManager& dmi_mgr = m_inst.get_dmi_manager();
         TlmPayload trans;
         uint64_t current_addr = addr;
         uint64_t temp;
-        init_payload(trans, tlm::TLM_IGNORE_COMMAND, current_addr, &temp, 0);
-        trans.set_dmi_allowed(true);
+        bool initialized = false;
+
+        /*
+         * All the aliases added below are committed to QEMU at once, the
+         * flatviews are regenerated a single time for the whole range.
+         */
+        m_inst.get().memory_region_transaction_begin();
 
         while (current_addr < addr + len) {
-            tlm::tlm_dmi dmi_data = check_dmi_hint_locked(trans);
+            tlm::tlm_dmi dmi_data;
+
+            if (dmi_mgr.topology_lookup(this, current_addr, dmi_data)) {
+                /* Already resolved by a previous mapping, nothing to do */
+                m_map_cache_hits++;
+            } else {
+                if (!initialized) {
+                    init_payload(trans, tlm::TLM_IGNORE_COMMAND, current_addr, &temp, 0);
+                    trans.set_dmi_allowed(true);
+                    initialized = true;
+                }
+                trans.set_address(current_addr);
+                bool authoritative;
+                dmi_data = check_dmi_hint_locked(trans, &authoritative);
+                m_map_cache_misses++;
+
+                if (authoritative && dmi_range_cacheable(dmi_data) && dmi_data.get_start_address() <= current_addr) {
+                    dmi_mgr.topology_insert(this, dmi_data);
+                }
+            }
 
             // Current addr is an absolute address while the dmi range might be relative
             // hence not necesseraly current_addr falls withing dmi_range address boundaries
             // TODO: is there a way to retrieve the dmi range block offset?
-            SCP_INFO(()) << "0x" << std::hex << current_addr << " mapped [0x" << dmi_data.get_start_address() << "-0x"
-                         << dmi_data.get_end_address() << "]";
+            SCP_DEBUG(()) << "0x" << std::hex << current_addr << " mapped [0x" << dmi_data.get_start_address()
+                          << "-0x" << dmi_data.get_end_address() << "]";
 
             // The allocated range may not span the whole length required for mapping
             assert(dmi_data.get_end_address() >= current_addr);
             current_addr = dmi_data.get_end_address();
             if (current_addr >= addr + len) break; // Catch potential loop-rounds
             current_addr += 1;
-            trans.set_address(current_addr);
         }
 
-        m_initiator.initiator_tidy_tlm_payload(trans);
+        m_inst.get().memory_region_transaction_commit();
+
+        if (initialized) {
+            m_initiator.initiator_tidy_tlm_payload(trans);
+        }
     }
 
     void init_global(qemu::Device& dev)
@@ -803,6 +1134,8 @@ public:
 private:
     void invalidate_single_range(sc_dt::uint64 start_range, sc_dt::uint64 end_range)
     {
+        m_inst.get_dmi_manager().topology_invalidate(this, start_range, end_range);
+
         auto it = m_dmi_aliases.upper_bound(start_range);
 
         if (it != m_dmi_aliases.begin()) {
@@ -858,6 +1191,9 @@ public:
         if (m_finished) return;
         SCP_DEBUG(()) << "DMI invalidate [0x" << std::hex << start_range << ", 0x" << std::hex << end_range << "]";
 
+        /* The aliases are removed later on, but no new mapping may rely on them from now on */
+        m_inst.get_dmi_manager().topology_invalidate(this, start_range, end_range);
+
         std::lock_guard<std::mutex> lock(m_mutex);
 
         for (auto m : m_mmio_mrs) {
@@ -905,6 +1241,8 @@ public:
     {
         std::lock_guard<std::mutex> lock(m_mutex);
 
+        m_inst.get_dmi_manager().topology_clear(this);
+
         for (auto m : m_mmio_mrs) {
             m.second->m_mapped_te.clear();
             auto it = m_dmi_aliases.begin();
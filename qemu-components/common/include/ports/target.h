@@ -9,8 +9,15 @@
 #ifndef _LIBQBOX_PORTS_TARGET_H
 #define _LIBQBOX_PORTS_TARGET_H
 
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+
 #include <tlm>
 
+#include <runonsysc.h>
+
 #include "qemu-instance.h"
 #include "tlm-extensions/qemu-cpu-hint.h"
 #include "tlm-extensions/qemu-mr-hint.h"
@@ -22,15 +29,75 @@ public:
     using MemTxAttrs = qemu::MemoryRegion::MemTxAttrs;
     using MemTxResult = qemu::MemoryRegion::MemTxResult;
     using TlmPayload = tlm::tlm_generic_payload;
+    using DmiInvalidateFn = std::function<void()>;
 
 protected:
     qemu::MemoryRegion m_mr;
+    /* With DMI, root of the address space: a background, and an alias of m_mr on top of it */
+    qemu::MemoryRegion m_dmi_root;
+    qemu::MemoryRegion m_dmi_alias;
     std::shared_ptr<qemu::AddressSpace> m_as;
 
+    /*
+     * DMI on the RAM sections of the QEMU memory region. This is opt-in as
+     * a RAM backed section may still need QEMU to see the accesses (e.g. a
+     * ROM device keeps its RAM block in I/O mode, or dirty tracking).
+     */
+    tlm::tlm_dmi::dmi_access_e m_dmi_access = tlm::tlm_dmi::DMI_ACCESS_NONE;
+    std::shared_ptr<qemu::MemoryListener> m_listener;
+    DmiInvalidateFn m_dmi_invalidate;
+
+    void init_dmi_root()
+    {
+        qemu::LibQemu& inst = m_mr.get_inst();
+        qemu::MemoryRegionOpsPtr ops = inst.memory_region_ops_new();
+
+        /* The background behaves as the hole it fills */
+        ops->set_read_callback([](uint64_t, uint64_t*, unsigned int, MemTxAttrs) -> MemTxResult {
+            return qemu::MemoryRegionOps::MemTxDecodeError;
+        });
+        ops->set_write_callback([](uint64_t, uint64_t, unsigned int, MemTxAttrs) -> MemTxResult {
+            return qemu::MemoryRegionOps::MemTxDecodeError;
+        });
+        ops->set_max_access_size(8);
+
+        m_dmi_root = inst.object_new_unparented<qemu::MemoryRegion>();
+        m_dmi_root.init_io(m_mr, "qemu-target-socket-dmi", m_mr.get_size(), ops);
+        m_dmi_alias = inst.object_new_unparented<qemu::MemoryRegion>();
+        m_dmi_alias.init_alias(m_mr, "qemu-target-socket-dmi-alias", m_mr, 0, m_mr.get_size());
+        m_dmi_root.add_subregion(m_dmi_alias, 0);
+    }
+
     void init_as()
     {
         m_as = m_mr.get_inst().address_space_new();
-        m_as->init(m_mr, "qemu-target-socket");
+
+        if (m_dmi_access == tlm::tlm_dmi::DMI_ACCESS_NONE) {
+            m_as->init(m_mr, "qemu-target-socket");
+        } else {
+            /*
+             * The listener only reports the sections added to the flatview.
+             * The background makes every change visible as an addition: a
+             * RAM section removed or shrunk uncovers it, and it is then
+             * mapped where the section was.
+             */
+            init_dmi_root();
+            m_as->init(m_dmi_root, "qemu-target-socket");
+
+            /*
+             * Any change in the flatview of the region (RAM remapped,
+             * subregion enabled/disabled or removed, ROM device switching
+             * mode, ...) may change the host pointer, invalidate what was
+             * granted.
+             */
+            m_listener = m_mr.get_inst().memory_listener_new();
+            m_listener->set_map_callback([this](qemu::MemoryListener&, uint64_t, uint64_t) {
+                if (m_dmi_invalidate) {
+                    m_dmi_invalidate();
+                }
+            });
+            m_listener->register_as(m_as);
+        }
     }
 
     qemu::Cpu push_current_cpu(TlmPayload& trans)
@@ -79,6 +146,13 @@ public:
         init_as();
     }
 
+    /* Must be called before init() */
+    void set_dmi_access(tlm::tlm_dmi::dmi_access_e access, DmiInvalidateFn invalidate)
+    {
+        m_dmi_access = access;
+        m_dmi_invalidate = invalidate;
+    }
+
     virtual void b_transport(TlmPayload& trans, sc_core::sc_time& t)
     {
         uint64_t addr = trans.get_address();
@@ -110,7 +184,14 @@ public:
             return;
         }
 
-        trans.set_extension(new QemuMrHintTlmExtension(m_mr, addr));
+        QemuMrHintTlmExtension* hint = nullptr;
+        trans.get_extension(hint);
+        if (hint == nullptr) {
+            hint = QemuMrHintTlmExtension::acquire();
+            trans.set_extension(hint);
+        }
+        hint->set_mr(m_mr);
+        hint->set_offset(addr);
 
         switch (res) {
         case qemu::MemoryRegionOps::MemTxOK:
@@ -140,7 +221,49 @@ public:
         return tlm::TLM_ACCEPTED;
     }
 
-    virtual bool get_direct_mem_ptr(TlmPayload& trans, tlm::tlm_dmi& dmi_data) { return false; }
+    virtual bool get_direct_mem_ptr(TlmPayload& trans, tlm::tlm_dmi& dmi_data)
+    {
+        /*
+         * A QEMU initiator probing the address map may ask which memory
+         * region sits behind this bridge, so that it can alias it directly if
+         * it belongs to the same instance.
+         */
+        QemuMrHintTlmExtension* ext = nullptr;
+        trans.get_extension(ext);
+        if (ext != nullptr) {
+            ext->set_mr(m_mr);
+            ext->set_offset(trans.get_address());
+        }
+
+        if (m_dmi_access == tlm::tlm_dmi::DMI_ACCESS_NONE) {
+            return false;
+        }
+
+        uint64_t addr = trans.get_address();
+        uint64_t size = m_mr.get_size();
+        if (addr >= size) {
+            return false;
+        }
+
+        /*
+         * The region may be a container, only grant the flatview section the
+         * address falls in, provided it is RAM backed.
+         */
+        uint64_t len = size - addr;
+        unsigned char* ptr = reinterpret_cast<unsigned char*>(m_as->get_ram_ptr(addr, len));
+        if (ptr == nullptr || len == 0) {
+            /* MMIO, or a hole in the region */
+            return false;
+        }
+
+        dmi_data.set_dmi_ptr(ptr);
+        dmi_data.set_start_address(addr);
+        dmi_data.set_end_address(addr + len - 1);
+        dmi_data.set_granted_access(m_dmi_access);
+        dmi_data.set_read_latency(sc_core::SC_ZERO_TIME);
+        dmi_data.set_write_latency(sc_core::SC_ZERO_TIME);
+        return true;
+    }
 
     virtual unsigned int transport_dbg(TlmPayload& trans)
     {
@@ -168,12 +291,45 @@ protected:
     QemuInstance& m_inst;
     qemu::SysBusDevice m_sbd;
 
+    std::unique_ptr<gs::runonsysc> m_on_sysc;
+    std::atomic<bool> m_dmi_invalidate_pending{ false };
+
+    /* Called from the QEMU thread owning the iothread lock */
+    void dmi_invalidate()
+    {
+        if (m_dmi_invalidate_pending.exchange(true)) {
+            /* A flatview rebuild calls us for every section, one invalidation is enough */
+            return;
+        }
+        m_on_sysc->fork_on_systemc([this]() {
+            m_dmi_invalidate_pending = false;
+            (*this)->invalidate_direct_mem_ptr(0, std::numeric_limits<sc_dt::uint64>::max());
+        });
+    }
+
 public:
     QemuTargetSocket(const char* name, QemuInstance& inst): TlmTargetSocket(name), m_inst(inst)
     {
         TlmTargetSocket::bind(m_bridge);
     }
 
+    /**
+     * @brief Grant DMI to SystemC initiators on the RAM backing the QEMU
+     * memory region behind this socket.
+     *
+     * @details Must be called during elaboration, before init(). The DMI
+     * pointers are invalidated whenever the QEMU memory topology of the
+     * region changes.
+     */
+    void set_dmi_access(tlm::tlm_dmi::dmi_access_e access)
+    {
+        if (access != tlm::tlm_dmi::DMI_ACCESS_NONE && !m_on_sysc) {
+            m_on_sysc = std::make_unique<gs::runonsysc>(
+                (std::string(TlmTargetSocket::basename()) + "_dmi_run_on_sysc").c_str());
+        }
+        m_bridge.set_dmi_access(access, std::bind(&QemuTargetSocket::dmi_invalidate, this));
+    }
+
     void init(qemu::SysBusDevice sbd, int mmio_idx) { m_bridge.init(sbd, mmio_idx); }
 
     void init_with_mr(qemu::MemoryRegion mr) { m_bridge.init_with_mr(mr); }
@@ -12,12 +12,13 @@
 #include <tlm>
 
 #include <libqemu-cxx/libqemu-cxx.h>
+#include <tlm-extensions/extension_pool.h>
 
-class QemuMrHintTlmExtension : public tlm::tlm_extension<QemuMrHintTlmExtension>
+class QemuMrHintTlmExtension : public gs::pooled_tlm_extension<QemuMrHintTlmExtension>
 {
 private:
     qemu::MemoryRegion m_mr;
-    uint64_t m_offset;
+    uint64_t m_offset = 0;
 
 public:
     QemuMrHintTlmExtension() = default;
@@ -33,6 +34,9 @@ public:
         m_offset = static_cast<const QemuMrHintTlmExtension&>(ext).m_offset;
     }
 
+    void set_mr(qemu::MemoryRegion mr) { m_mr = mr; }
+    void set_offset(uint64_t offset) { m_offset = offset; }
+
     qemu::MemoryRegion get_mr() const { return m_mr; }
     uint64_t get_offset() const { return m_offset; }
 };
@@ -8,6 +8,7 @@
 
 #include <cstring>
 #include <cassert>
+#include <limits>
 
 #include <libqemu/libqemu.h>
 
@@ -89,6 +90,15 @@ void LibQemu::init()
 
     m_int = std::make_shared<LibQemuInternals>(*this, exports);
     init_callbacks();
+    resolve_ram_access();
+}
+
+void* LibQemu::get_optional_symbol(const char* name)
+{
+    if (!m_lib->symbol_exists(name)) {
+        return nullptr;
+    }
+    return m_lib->get_symbol(name);
 }
 
 void LibQemu::start_gdb_server(std::string port)
@@ -199,12 +209,96 @@ void LibQemu::lock_iothread() { m_int->exports().qemu_mutex_lock_iothread(); }
 
 void LibQemu::unlock_iothread() { m_int->exports().qemu_mutex_unlock_iothread(); }
 
+bool LibQemu::iothread_locked() { return m_iothread_locked && m_iothread_locked(); }
+
+void LibQemu::resolve_ram_access()
+{
+    m_mr_get_ram_addr = reinterpret_cast<uint64_t (*)(QemuMemoryRegion*)>(
+        get_optional_symbol("memory_region_get_ram_addr"));
+    m_mr_get_ram_ptr = reinterpret_cast<void* (*)(QemuMemoryRegion*)>(get_optional_symbol("memory_region_get_ram_ptr"));
+    m_as_get_flatview = reinterpret_cast<void* (*)(QemuAddressSpace*)>(
+        get_optional_symbol("address_space_get_flatview"));
+    m_flatview_unref = reinterpret_cast<void (*)(void*)>(get_optional_symbol("flatview_unref"));
+    m_flatview_translate = reinterpret_cast<QemuMemoryRegion* (*)(void*, uint64_t, uint64_t*, uint64_t*, bool,
+                                                                  ::MemTxAttrs)>(
+        get_optional_symbol("flatview_translate"));
+
+    /* renamed in QEMU 9.0 */
+    m_iothread_locked = reinterpret_cast<bool (*)()>(get_optional_symbol("bql_locked"));
+    if (m_iothread_locked == nullptr) {
+        m_iothread_locked = reinterpret_cast<bool (*)()>(get_optional_symbol("qemu_mutex_iothread_locked"));
+    }
+}
+
+void* LibQemu::memory_region_get_ram_ptr(QemuMemoryRegion* mr)
+{
+    static constexpr uint64_t RAM_ADDR_INVALID = std::numeric_limits<uint64_t>::max();
+
+    if (m_mr_get_ram_addr == nullptr || m_mr_get_ram_ptr == nullptr) {
+        return nullptr;
+    }
+    if (m_mr_get_ram_addr(mr) == RAM_ADDR_INVALID) {
+        return nullptr;
+    }
+    return m_mr_get_ram_ptr(mr);
+}
+
+void* LibQemu::address_space_translate_ram(QemuAddressSpace* as, uint64_t addr, uint64_t& len)
+{
+    if (m_as_get_flatview == nullptr || m_flatview_unref == nullptr || m_flatview_translate == nullptr) {
+        return nullptr;
+    }
+
+    ::MemTxAttrs attrs = {};
+    uint64_t xlat = 0;
+    uint64_t plen = len;
+    void* fv = m_as_get_flatview(as);
+    QemuMemoryRegion* mr = m_flatview_translate(fv, addr, &xlat, &plen, false, attrs);
+    uint8_t* ptr = mr ? static_cast<uint8_t*>(memory_region_get_ram_ptr(mr)) : nullptr;
+    m_flatview_unref(fv);
+
+    if (ptr == nullptr) {
+        return nullptr;
+    }
+    len = plen;
+    return ptr + xlat;
+}
+
 void LibQemu::rcu_read_lock() { m_int->exports().rcu_read_lock(); }
 
 void LibQemu::rcu_read_unlock() { m_int->exports().rcu_read_unlock(); }
 
 RcuReadLock LibQemu::rcu_read_lock_new() { return RcuReadLock(m_int); }
 
+void LibQemu::resolve_mr_transaction()
+{
+    m_mr_transaction_begin = reinterpret_cast<void (*)()>(get_optional_symbol("memory_region_transaction_begin"));
+    m_mr_transaction_commit = reinterpret_cast<void (*)()>(get_optional_symbol("memory_region_transaction_commit"));
+
+    if (m_mr_transaction_begin == nullptr || m_mr_transaction_commit == nullptr) {
+        m_mr_transaction_begin = nullptr;
+        m_mr_transaction_commit = nullptr;
+    }
+    m_mr_transaction_resolved = true;
+}
+
+void LibQemu::memory_region_transaction_begin()
+{
+    if (!m_mr_transaction_resolved) {
+        resolve_mr_transaction();
+    }
+    if (m_mr_transaction_begin) {
+        m_mr_transaction_begin();
+    }
+}
+
+void LibQemu::memory_region_transaction_commit()
+{
+    if (m_mr_transaction_commit) {
+        m_mr_transaction_commit();
+    }
+}
+
 void LibQemu::coroutine_yield() { m_int->exports().coroutine_yield(); }
 
 void LibQemu::finish_qemu_init() { m_int->exports().finish_qemu_init(); }
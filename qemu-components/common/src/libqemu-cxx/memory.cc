@@ -17,6 +17,28 @@
 
 namespace qemu {
 
+/* Holds the iothread lock for its scope, unless the calling thread already does */
+class IothreadLockGuard
+{
+    LibQemu& m_inst;
+    bool m_locked;
+
+public:
+    IothreadLockGuard(LibQemu& inst): m_inst(inst), m_locked(!inst.iothread_locked())
+    {
+        if (m_locked) {
+            m_inst.lock_iothread();
+        }
+    }
+    ~IothreadLockGuard()
+    {
+        if (m_locked) {
+            m_inst.unlock_iothread();
+        }
+    }
+    IothreadLockGuard(const IothreadLockGuard&) = delete;
+};
+
 /* ::MemTxtResult <-> MemoryRegionOps::MemTxResult mapping */
 static inline MemoryRegionOps::MemTxResult QEMU_TO_LIB_MEMTXRESULT_MAPPING(uint32_t value)
 {
@@ -170,6 +192,14 @@ void MemoryRegion::init_alias(Object owner, const char* name, const MemoryRegion
     m_int->exports().memory_region_init_alias(mr, owner.get_qemu_obj(), name, root_mr, offset, size);
 }
 
+void* MemoryRegion::get_ram_ptr()
+{
+    LibQemu& inst = get_inst();
+    IothreadLockGuard lock(inst);
+
+    return inst.memory_region_get_ram_ptr(reinterpret_cast<QemuMemoryRegion*>(m_obj));
+}
+
 void MemoryRegion::add_subregion(MemoryRegion& mr, uint64_t offset)
 {
     QemuMemoryRegion* this_mr = reinterpret_cast<QemuMemoryRegion*>(m_obj);
@@ -308,6 +338,15 @@ AddressSpace::MemTxResult AddressSpace::write(uint64_t addr, const void* data, s
     return QEMU_TO_LIB_MEMTXRESULT_MAPPING(qemu_res);
 }
 
+void* AddressSpace::get_ram_ptr(uint64_t addr, uint64_t& len)
+{
+    LibQemu& inst = m_int->get_inst();
+    IothreadLockGuard lock(inst);
+    RcuReadLock rcu = inst.rcu_read_lock_new();
+
+    return inst.address_space_translate_ram(m_as, addr, len);
+}
+
 void AddressSpace::update_topology() { m_int->exports().address_space_update_topology(m_as); }
 
 MemoryListener::MemoryListener(std::shared_ptr<LibQemuInternals> internals): m_ml{ nullptr }, m_int(internals) {}
@@ -41,7 +41,8 @@ protected:
 
     void add_exclusive_ext(TlmPayload& pl)
     {
-        ExclusiveAccessTlmExtension* ext = new ExclusiveAccessTlmExtension;
+        ExclusiveAccessTlmExtension* ext = ExclusiveAccessTlmExtension::acquire();
+        ext->reset();
         ext->add_hop(m_cpu.get_index());
         pl.set_extension(ext);
     }
@@ -238,7 +239,7 @@ public:
         }
 
         payload.clear_extension(ext);
-        delete ext;
+        ext->free();
 
         if (exit_tb) {
             /*
@@ -40,7 +40,8 @@ protected:
 
     void add_exclusive_ext(TlmPayload& pl)
     {
-        ExclusiveAccessTlmExtension* ext = new ExclusiveAccessTlmExtension;
+        ExclusiveAccessTlmExtension* ext = ExclusiveAccessTlmExtension::acquire();
+        ext->reset();
         ext->add_hop(m_cpu.get_index());
         pl.set_extension(ext);
     }
@@ -231,7 +232,7 @@ public:
         }
 
         payload.clear_extension(ext);
-        delete ext;
+        ext->free();
 
         if (exit_tb) {
             /*
@@ -95,6 +95,9 @@ protected:
     cci::cci_param<uint64_t> p_mmio_high_addr;
     cci::cci_param<uint64_t> p_mmio_high_size;
 
+    /* Grant DMI on the RAM backed BARs (e.g. ivshmem) mapped in the MMIO windows */
+    cci::cci_param<bool> p_mmio_dmi;
+
     qemu::MemoryRegion m_mmio_alias;
     qemu::MemoryRegion m_mmio_high_alias;
 
@@ -119,9 +122,15 @@ public:
         , p_mmio_size("mmio_iface.size", mmio_size, "Interface MMIO size")
         , p_mmio_high_addr("mmio_iface_high.address", mmio_high_addr, "High Interface MMIO address")
         , p_mmio_high_size("mmio_iface_high.size", mmio_high_size, "High Interface MMIO size")
+        , p_mmio_dmi("mmio_dmi", false, "Grant DMI on the RAM backed BARs mapped in the MMIO interfaces")
         , devices()
     {
         sc_assert(p_mmio_addr != 0);
+
+        if (p_mmio_dmi) {
+            mmio_iface.set_dmi_access(tlm::tlm_dmi::DMI_ACCESS_READ_WRITE);
+            mmio_iface_high.set_dmi_access(tlm::tlm_dmi::DMI_ACCESS_READ_WRITE);
+        }
     }
 
     void add_device(Device& dev)
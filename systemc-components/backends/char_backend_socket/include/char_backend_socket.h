@@ -308,6 +308,10 @@ public:
 
     void forward_incoming_data(size_t data_length)
     {
+        if (!p_sigquit) {
+            m_biflow_socket.enqueue(reinterpret_cast<const uint8_t*>(m_buffer.data()), data_length);
+            return;
+        }
         for (size_t i = 0; i < data_length; i++) {
             unsigned char c = m_buffer[i];
             if (p_sigquit && c == 0x1c) {
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <deque>
+
+#include <backends/net-backend.h>
+
+/*
+ * Network backend giving every frame sent back to the MAC it is attached to. The frames sent during one delta cycle
+ * are delivered together in the next one, at most max_frames of them are queued.
+ */
+class NetworkBackendLoopback : public NetworkBackend, public sc_core::sc_module
+{
+private:
+    sc_core::sc_event m_event;
+    PayloadPool m_pool;
+    std::deque<Payload*> m_queue;
+    size_t m_max_frames;
+    uint64_t m_dropped;
+
+    void rcv();
+
+public:
+    NetworkBackendLoopback(sc_core::sc_module_name name, size_t max_frames = 256);
+
+    virtual ~NetworkBackendLoopback();
+
+    void send(Payload& frame);
+
+    /* Frames dropped because the queue was full or no MAC was attached */
+    uint64_t dropped() const { return m_dropped; }
+};
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <systemc>
+
+/*
+ * Ethernet frames captured to a pcap file, stamped with the simulation time. The records go through a large stdio
+ * buffer, the file is only written when it is full, on flush() and on close().
+ */
+class PcapWriter
+{
+private:
+    std::FILE* m_file;
+    std::vector<char> m_buffer;
+    uint64_t m_frames;
+
+public:
+    static constexpr size_t BUFFER_SIZE = 1 << 20;
+    static constexpr uint32_t SNAPLEN = 65535;
+
+    PcapWriter(): m_file(nullptr), m_frames(0) {}
+    ~PcapWriter() { close(); }
+
+    bool open(const std::string& path)
+    {
+        close();
+        m_file = std::fopen(path.c_str(), "wb");
+        if (!m_file) {
+            return false;
+        }
+        m_buffer.resize(BUFFER_SIZE);
+        std::setvbuf(m_file, m_buffer.data(), _IOFBF, m_buffer.size());
+
+        struct {
+            uint32_t magic;
+            uint16_t version_major;
+            uint16_t version_minor;
+            int32_t thiszone;
+            uint32_t sigfigs;
+            uint32_t snaplen;
+            uint32_t linktype;
+        } header = { 0xa1b2c3d4, 2, 4, 0, 0, SNAPLEN, 1 /* LINKTYPE_ETHERNET */ };
+        std::fwrite(&header, sizeof(header), 1, m_file);
+        return true;
+    }
+
+    bool is_open() const { return m_file != nullptr; }
+    uint64_t frames() const { return m_frames; }
+
+    void write(const sc_core::sc_time& stamp, const uint8_t* data, size_t len)
+    {
+        if (!m_file) {
+            return;
+        }
+        uint64_t us = stamp.value() / sc_core::sc_time(1, sc_core::SC_US).value();
+        uint32_t caplen = len < SNAPLEN ? len : SNAPLEN;
+        struct {
+            uint32_t ts_sec;
+            uint32_t ts_usec;
+            uint32_t incl_len;
+            uint32_t orig_len;
+        } record = { uint32_t(us / 1000000), uint32_t(us % 1000000), caplen, uint32_t(len) };
+        std::fwrite(&record, sizeof(record), 1, m_file);
+        std::fwrite(data, 1, caplen, m_file);
+        m_frames++;
+    }
+
+    void flush()
+    {
+        if (m_file) {
+            std::fflush(m_file);
+        }
+    }
+
+    void close()
+    {
+        if (m_file) {
+            std::fclose(m_file);
+            m_file = nullptr;
+        }
+    }
+
+private:
+    PcapWriter(const PcapWriter&);
+    PcapWriter& operator=(const PcapWriter&);
+};
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/types.h>
+
+#include <cci_configuration>
+#include <scp/report.h>
+
+#include <async_event.h>
+#include <backends/net-backend.h>
+#include <backends/pcap.h>
+
+/*
+ * Learning Ethernet switch between the MACs of a simulation, without any host network device.
+ *
+ * Each MAC gets its own port (add_port()), and is attached to it with set_backend(). The switch learns on which port
+ * each source address is, and forwards a unicast frame only to the port of its destination once known. Broadcast,
+ * multicast and unknown destinations are flooded.
+ *
+ * The frames are queued per port and delivered together, in the next delta cycle, or at the next multiple of
+ * delivery_period when it is set (e.g. the quantum), so that the MACs handle them in batches.
+ *
+ * Two simulators can be connected by giving their switches the same shm_link name: the frames going out of one are
+ * passed to the other through a pair of rings in shared memory, as if coming from an extra port.
+ */
+class NetworkSwitch : public sc_core::sc_module
+{
+    SCP_LOGGER(());
+
+public:
+    class Port : public NetworkBackend
+    {
+    private:
+        NetworkSwitch& m_switch;
+        int m_id;
+
+    public:
+        Port(NetworkSwitch& sw, int id): m_switch(sw), m_id(id) {}
+
+        void send(Payload& frame) { m_switch.forward(m_id, frame.data(), frame.size()); }
+
+        bool attached() const { return m_receive != nullptr; }
+        bool can_receive() { return !m_can_receive || m_can_receive(m_opaque); }
+        void receive(Payload& frame) { m_receive(m_opaque, frame); }
+    };
+
+    cci::cci_param<std::string> p_pcap;
+    cci::cci_param<sc_core::sc_time> p_delivery_period;
+    cci::cci_param<uint32_t> p_queue_frames;
+    cci::cci_param<std::string> p_shm_link;
+
+    NetworkSwitch(const sc_core::sc_module_name& name);
+    virtual ~NetworkSwitch();
+
+    /* A new port, to give to the set_backend() of a MAC */
+    Port* add_port();
+
+    uint64_t forwarded() const { return m_forwarded; }
+    uint64_t dropped() const { return m_dropped; }
+
+private:
+    static constexpr int UPLINK = -1;
+    static constexpr size_t MAX_FRAME_SIZE = 9018;
+
+    struct shm_ring {
+        static constexpr uint32_t SLOTS = 256;
+        std::atomic<uint32_t> head; // next slot written
+        std::atomic<uint32_t> tail; // next slot read
+        struct {
+            uint32_t len;
+            uint8_t data[MAX_FRAME_SIZE];
+        } slots[SLOTS];
+    };
+
+    /*
+     * One ring per direction, side N sends in rings[N]. attached[N] is the pid of the simulator using side N, 0 if
+     * none: a side left by a simulator which died without closing the link is reclaimed.
+     */
+    struct shm_link {
+        std::atomic<pid_t> attached[2];
+        shm_ring rings[2];
+    };
+
+    std::vector<std::unique_ptr<Port>> m_ports;
+    std::vector<std::deque<Payload*>> m_queues;
+    std::unordered_map<uint64_t, int> m_fdb; // MAC address -> port
+    PayloadPool m_pool;
+    PcapWriter m_pcap;
+    sc_core::sc_event m_deliver_event;
+    uint64_t m_forwarded;
+    uint64_t m_dropped;
+
+    shm_link* m_link;
+    int m_link_side;
+    gs::async_event m_link_event;
+    std::atomic<bool> m_link_notified;
+    std::atomic<bool> m_link_stop;
+    std::thread m_link_thread;
+
+    void forward(int from, const uint8_t* data, size_t len);
+    void enqueue(int to, const uint8_t* data, size_t len);
+    void schedule_delivery();
+    void deliver();
+
+    void open_link(const std::string& name);
+    void close_link();
+    void link_send(const uint8_t* data, size_t len);
+    void link_receive();
+    void link_poll();
+
+    void end_of_simulation() { m_pcap.flush(); }
+};
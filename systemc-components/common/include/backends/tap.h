@@ -18,6 +18,7 @@ class NetworkBackendTap : public NetworkBackend, public sc_core::sc_module
 {
 private:
     gs::async_event m_event;
+    PayloadPool m_pool;
     std::queue<Payload*> m_queue;
     std::mutex m_mutex;
     int m_fd;
@@ -11,6 +11,8 @@
 #include <scp/report.h>
 #include <iostream>
 #include <list>
+#include <map>
+#include <memory>
 #include <regex>
 #include <unordered_set>
 
@@ -185,6 +187,51 @@ std::list<std::string> sc_cci_children(sc_core::sc_module_name name);
  */
 std::list<std::string> sc_cci_list_items(sc_core::sc_module_name module_name, std::string list_name);
 
+/**
+ * @brief Prefix tree of the 'unconsumed' preset values below a given name, keyed by the
+ * components of their hierarchical names. It is built with a single pass over the broker and
+ * then answers sc_cci_children() like questions, or prefix searches, without scanning all the
+ * preset values again. It is a snapshot: values consumed or added after build() are not seen.
+ */
+class cci_preset_index
+{
+    struct node {
+        std::map<std::string, std::unique_ptr<node>> children;
+        const std::pair<std::string, cci::cci_value>* value = nullptr;
+    };
+
+    std::vector<std::pair<std::string, cci::cci_value>> m_values;
+    node m_root;
+
+    const node* find(const std::string& name) const;
+
+    template <typename F>
+    static void visit(const node& n, F& fn)
+    {
+        if (n.value) fn(n.value->first, n.value->second);
+        for (auto& c : n.children) visit(*c.second, fn);
+    }
+
+public:
+    /* Index the unconsumed preset values starting with prefix (all of them if empty) */
+    void build(cci::cci_broker_handle broker, const std::string& prefix = "");
+    void clear();
+
+    size_t size() const { return m_values.size(); }
+
+    /* Sorted names of the direct children of name, as sc_cci_children() */
+    std::list<std::string> children(const std::string& name) const;
+
+    /* Call fn(full_name, value) for every preset value below name (not name itself) */
+    template <typename F>
+    void for_each(const std::string& name, F fn) const
+    {
+        const node* n = find(name);
+        if (!n) return;
+        for (auto& c : n->children) visit(*c.second, fn);
+    }
+};
+
 std::string get_parent_name(sc_core::sc_module_name n);
 
 cci::cci_value cci_get(cci::cci_broker_handle broker, std::string name);
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _GREENSOCS_BASE_COMPONENTS_DMA_INITIATOR_H
+#define _GREENSOCS_BASE_COMPONENTS_DMA_INITIATOR_H
+
+#include <systemc>
+#include <tlm>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <cci_configuration>
+#include <scp/report.h>
+#include <tlm_sockets_buswidth.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gs {
+
+/**
+ * @brief Memory accesses of a DMA capable device model (descriptor rings, frame buffers...).
+ *
+ * Accesses are served from a cache of the DMI windows granted by the targets, and go through b_transport otherwise.
+ * A window is requested whenever a transaction comes back with the DMI hint, and is dropped when the target
+ * invalidates it. Scatter/gather lists are copied to or from a contiguous buffer.
+ *
+ * Copies of at least async_min_size bytes that fall in a single DMI window can be handed to a worker thread with
+ * read_async()/write_async(). The buffer must stay valid until sync(). Every other access, and every invalidation,
+ * waits for the pending copies first, so they are seen in order.
+ */
+template <unsigned int BUSWIDTH = DEFAULT_TLM_BUSWIDTH>
+class dma_initiator : public sc_core::sc_module
+{
+    SCP_LOGGER(());
+
+public:
+    struct sg_entry {
+        uint64_t addr;
+        uint64_t len;
+    };
+
+    tlm_utils::simple_initiator_socket<dma_initiator<BUSWIDTH>, BUSWIDTH> socket;
+    cci::cci_param<uint64_t> p_max_dmi_windows;
+    cci::cci_param<uint64_t> p_async_min_size;
+
+    dma_initiator(const sc_core::sc_module_name& name)
+        : sc_core::sc_module(name)
+        , socket("socket")
+        , p_max_dmi_windows("max_dmi_windows", 16, "Number of DMI windows cached, the cache is emptied when full")
+        , p_async_min_size("async_min_size", 0,
+                           "Smallest copy handed to the worker thread by read_async/write_async, 0 to disable")
+    {
+        SCP_TRACE(()) << "constructor";
+        socket.register_invalidate_direct_mem_ptr(this, &dma_initiator::invalidate_direct_mem_ptr);
+    }
+
+    ~dma_initiator()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        if (m_worker.joinable()) m_worker.join();
+    }
+
+    bool read(uint64_t addr, uint8_t* data, uint64_t len) { return access(addr, data, len, false); }
+
+    bool write(uint64_t addr, const uint8_t* data, uint64_t len)
+    {
+        return access(addr, const_cast<uint8_t*>(data), len, true);
+    }
+
+    /* Gather the entries of sg into data */
+    bool read(const std::vector<sg_entry>& sg, uint8_t* data)
+    {
+        for (const auto& e : sg) {
+            if (!read(e.addr, data, e.len)) return false;
+            data += e.len;
+        }
+        return true;
+    }
+
+    /* Scatter data into the entries of sg */
+    bool write(const std::vector<sg_entry>& sg, const uint8_t* data)
+    {
+        for (const auto& e : sg) {
+            if (!write(e.addr, data, e.len)) return false;
+            data += e.len;
+        }
+        return true;
+    }
+
+    bool read_async(uint64_t addr, uint8_t* data, uint64_t len)
+    {
+        unsigned char* ptr = async_dmi_ptr(addr, len, false);
+        if (!ptr) return read(addr, data, len);
+        queue_copy(data, ptr, len);
+        return true;
+    }
+
+    bool write_async(uint64_t addr, const uint8_t* data, uint64_t len)
+    {
+        unsigned char* ptr = async_dmi_ptr(addr, len, true);
+        if (!ptr) return write(addr, data, len);
+        queue_copy(ptr, data, len);
+        return true;
+    }
+
+    /* Wait for the copies queued by read_async/write_async */
+    void sync()
+    {
+        if (!m_pending) return;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_pending == 0; });
+    }
+
+    void invalidate_direct_mem_ptr(sc_dt::uint64 start, sc_dt::uint64 end)
+    {
+        sync();
+        SCP_DEBUG(()) << "invalidate DMI [0x" << std::hex << start << " - 0x" << end << "]";
+        drop_windows(start, end);
+    }
+
+    /* Number of accesses that went through b_transport */
+    uint64_t transport_count() const { return m_transports; }
+
+private:
+    struct copy_job {
+        uint8_t* dst;
+        const uint8_t* src;
+        uint64_t len;
+    };
+
+    std::map<uint64_t, tlm::tlm_dmi> m_dmi_windows; // by start address
+    uint64_t m_transports = 0;
+
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<copy_job> m_jobs;
+    std::atomic<uint64_t> m_pending{ 0 };
+    bool m_stop = false;
+
+    bool access(uint64_t addr, uint8_t* data, uint64_t len, bool is_write)
+    {
+        sync();
+        while (len) {
+            uint64_t n = dmi_copy(addr, data, len, is_write);
+            if (!n) return transport(addr, data, len, is_write);
+            addr += n;
+            data += n;
+            len -= n;
+        }
+        return true;
+    }
+
+    /* The cached window holding addr with the requested access, if any */
+    const tlm::tlm_dmi* find_window(uint64_t addr, bool is_write) const
+    {
+        auto it = m_dmi_windows.upper_bound(addr);
+        if (it == m_dmi_windows.begin()) return nullptr;
+        --it;
+        const tlm::tlm_dmi& dmi = it->second;
+        if (addr > dmi.get_end_address()) return nullptr;
+        if (is_write ? !dmi.is_write_allowed() : !dmi.is_read_allowed()) return nullptr;
+        return &dmi;
+    }
+
+    /* Copy as much as possible from the start of the access through DMI, return the number of bytes copied */
+    uint64_t dmi_copy(uint64_t addr, uint8_t* data, uint64_t len, bool is_write)
+    {
+        const tlm::tlm_dmi* dmi = find_window(addr, is_write);
+        if (!dmi) return 0;
+        uint64_t n = std::min<uint64_t>(len, dmi->get_end_address() - addr + 1);
+        unsigned char* ptr = dmi->get_dmi_ptr() + (addr - dmi->get_start_address());
+        if (is_write) {
+            memcpy(ptr, data, n);
+        } else {
+            memcpy(data, ptr, n);
+        }
+        return n;
+    }
+
+    bool transport(uint64_t addr, uint8_t* data, uint64_t len, bool is_write)
+    {
+        tlm::tlm_generic_payload trans;
+        sc_core::sc_time delay(sc_core::SC_ZERO_TIME);
+
+        trans.set_command(is_write ? tlm::TLM_WRITE_COMMAND : tlm::TLM_READ_COMMAND);
+        trans.set_address(addr);
+        trans.set_data_ptr(reinterpret_cast<unsigned char*>(data));
+        trans.set_data_length(len);
+        trans.set_streaming_width(len);
+        trans.set_byte_enable_length(0);
+        trans.set_dmi_allowed(false);
+        trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+
+        m_transports++;
+        socket->b_transport(trans, delay);
+
+        if (trans.get_response_status() != tlm::TLM_OK_RESPONSE) {
+            SCP_WARN(()) << (is_write ? "write" : "read") << " of " << std::dec << len << " bytes at 0x" << std::hex
+                         << addr << " failed: " << trans.get_response_string();
+            return false;
+        }
+        if (trans.is_dmi_allowed()) request_dmi(trans);
+        return true;
+    }
+
+    void request_dmi(tlm::tlm_generic_payload& trans)
+    {
+        tlm::tlm_dmi dmi;
+        if (!socket->get_direct_mem_ptr(trans, dmi)) return;
+        if (m_dmi_windows.size() >= p_max_dmi_windows) {
+            SCP_DEBUG(()) << "DMI cache full, emptying it";
+            m_dmi_windows.clear();
+        }
+        drop_windows(dmi.get_start_address(), dmi.get_end_address());
+        SCP_DEBUG(()) << "DMI window [0x" << std::hex << dmi.get_start_address() << " - 0x" << dmi.get_end_address()
+                      << "]" << (dmi.is_write_allowed() ? "" : " (read only)");
+        m_dmi_windows.emplace(dmi.get_start_address(), dmi);
+    }
+
+    void drop_windows(uint64_t start, uint64_t end)
+    {
+        auto it = m_dmi_windows.upper_bound(start);
+        if (it != m_dmi_windows.begin()) --it;
+        while (it != m_dmi_windows.end() && it->first <= end) {
+            if (it->second.get_end_address() >= start) {
+                it = m_dmi_windows.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    unsigned char* async_dmi_ptr(uint64_t addr, uint64_t len, bool is_write)
+    {
+        if (!p_async_min_size || len < p_async_min_size) return nullptr;
+        const tlm::tlm_dmi* dmi = find_window(addr, is_write);
+        if (!dmi || (dmi->get_end_address() - addr) < (len - 1)) return nullptr;
+        return dmi->get_dmi_ptr() + (addr - dmi->get_start_address());
+    }
+
+    void queue_copy(uint8_t* dst, const uint8_t* src, uint64_t len)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_worker.joinable()) m_worker = std::thread(&dma_initiator::worker, this);
+            m_jobs.push_back({ dst, src, len });
+            m_pending++;
+        }
+        m_cv.notify_all();
+    }
+
+    void worker()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_cv.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+            if (m_jobs.empty()) return;
+            copy_job job = m_jobs.front();
+            m_jobs.pop_front();
+            lock.unlock();
+            memcpy(job.dst, job.src, job.len);
+            lock.lock();
+            if (--m_pending == 0) m_cv.notify_all();
+        }
+    }
+};
+} // namespace gs
+
+#endif
@@ -8,9 +8,11 @@
 #include "async_event.h"
 #include "qk_factory.h"
 #include "qkmultithread.h"
+#include "qkmulti-lockfree.h"
 #include "qkmulti-quantum.h"
 #include "qkmulti-rolling.h"
 #include "qkmulti-adaptive.h"
+#include "qkmulti-adaptive-rate.h"
 #include "qkmulti-unconstrained.h"
 #include "qkmulti-freerunning.h"
 #include "inlinesync.h"
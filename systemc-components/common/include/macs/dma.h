@@ -6,57 +6,59 @@
  */
 
 #pragma once
-#include <tlm_sockets_buswidth.h>
-#include <module_factory_registery.h>
+#include <dma_initiator.h>
 
-class dma : public sc_core::sc_module
-{
-public:
-    tlm_utils::simple_initiator_socket<dma, DEFAULT_TLM_BUSWIDTH> socket;
+#include <vector>
 
-    tlm::tlm_dmi dmi_data;
-    bool dmi_valid;
+/* Memory accesses of the MAC models: descriptors and frame buffers */
+using dma = gs::dma_initiator<>;
+
+/*
+ * Descriptor accesses of one ring. The write-backs to consecutive descriptors are merged in a single DMA write, done
+ * by flush(). A read of a descriptor with a pending write-back flushes first, so a ring wrapping inside one batch
+ * still sees its own updates. Flush before raising the interrupt telling the guest about the descriptors.
+ */
+class desc_ring_batch
+{
+private:
+    dma& m_dma;
+    uint64_t m_start = 0;
+    std::vector<uint8_t> m_data;
 
-    dma(const sc_core::sc_module_name& name): sc_core::sc_module(name), socket("socket") { dmi_valid = false; }
+public:
+    static constexpr size_t MAX_BATCH_SIZE = 4096;
 
-    ~dma() {}
+    desc_ring_batch(dma& dma_inst): m_dma(dma_inst) { m_data.reserve(MAX_BATCH_SIZE); }
 
-    void bus_do(uint64_t addr, uint8_t* data, uint32_t size, bool is_write)
+    bool read(uint64_t addr, void* desc, size_t len)
     {
-        tlm::tlm_generic_payload trans;
-
-        if (dmi_valid && addr >= dmi_data.get_start_address() && (addr + size) < dmi_data.get_end_address()) {
-            if (is_write && dmi_data.is_write_allowed()) {
-                uint64_t off = addr - dmi_data.get_start_address();
-                unsigned char* ptr = dmi_data.get_dmi_ptr();
-                memcpy(ptr + off, data, size);
-                return;
-            } else if (!is_write && dmi_data.is_read_allowed()) {
-                uint64_t off = addr - dmi_data.get_start_address();
-                unsigned char* ptr = dmi_data.get_dmi_ptr();
-                memcpy(data, ptr + off, size);
-                return;
-            }
+        if (!m_data.empty() && addr < m_start + m_data.size() && m_start < addr + len) {
+            flush();
         }
+        return m_dma.read(addr, reinterpret_cast<uint8_t*>(desc), len);
+    }
 
-        trans.set_command(is_write ? tlm::TLM_WRITE_COMMAND : tlm::TLM_READ_COMMAND);
-        trans.set_address(addr);
-        trans.set_data_ptr(reinterpret_cast<unsigned char*>(data));
-        trans.set_data_length(size);
-        trans.set_streaming_width(size);
-        trans.set_byte_enable_length(0);
-        trans.set_dmi_allowed(false);
-        trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
-
-        sc_core::sc_time delay(sc_core::SC_ZERO_TIME);
-        socket->b_transport(trans, delay);
-
-        if (trans.is_dmi_allowed()) {
-            dmi_valid = socket->get_direct_mem_ptr(trans, dmi_data);
+    void write(uint64_t addr, const void* desc, size_t len)
+    {
+        if (!m_data.empty() && (addr != m_start + m_data.size() || m_data.size() + len > MAX_BATCH_SIZE)) {
+            flush();
+        }
+        if (m_data.empty()) {
+            m_start = addr;
         }
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(desc);
+        m_data.insert(m_data.end(), bytes, bytes + len);
     }
 
-    void bus_write(uint64_t addr, uint8_t* data, uint32_t size) { bus_do(addr, data, size, 1); }
+    bool flush()
+    {
+        if (m_data.empty()) {
+            return true;
+        }
+        bool ok = m_dma.write(m_start, m_data.data(), m_data.size());
+        m_data.clear();
+        return ok;
+    }
 
-    void bus_read(uint64_t addr, uint8_t* data, uint32_t size) { bus_do(addr, data, size, 0); }
+    bool pending() const { return !m_data.empty(); }
 };
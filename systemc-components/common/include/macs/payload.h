@@ -11,6 +11,9 @@
 #include <sys/types.h>
 #include <systemc>
 
+#include <mutex>
+#include <vector>
+
 class Payload
 {
 private:
@@ -42,3 +45,47 @@ private:
     Payload(const Payload&);
     Payload& operator=(const Payload&);
 };
+
+/* Frames recycled between uses, so that the receive paths of the backends do not allocate a buffer per frame */
+class PayloadPool
+{
+private:
+    std::mutex m_mutex;
+    std::vector<Payload*> m_free;
+    size_t m_capacity;
+
+public:
+    PayloadPool(size_t capacity): m_capacity(capacity) {}
+    ~PayloadPool()
+    {
+        for (Payload* frame : m_free) {
+            delete frame;
+        }
+    }
+
+    size_t capacity() const { return m_capacity; }
+
+    Payload* get()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_free.empty()) {
+                Payload* frame = m_free.back();
+                m_free.pop_back();
+                frame->resize(0);
+                return frame;
+            }
+        }
+        return new Payload(m_capacity);
+    }
+
+    void put(Payload* frame)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_free.push_back(frame);
+    }
+
+private:
+    PayloadPool(const PayloadPool&);
+    PayloadPool& operator=(const PayloadPool&);
+};
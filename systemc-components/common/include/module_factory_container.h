@@ -71,6 +71,25 @@ private:
         m_per_pass_nested_deps_cache; // Per-pass cache: container_name -> deps (cleared each pass)
     mutable std::map<std::string, bool> m_is_container_type_cache; // Cache for is_container_type() results
 
+    // Snapshot of this container's unconsumed presets, valid while constructing and binding
+    gs::cci_preset_index m_presets;
+    bool m_presets_valid = false;
+
+    const gs::cci_preset_index& presets()
+    {
+        if (!m_presets_valid) {
+            m_presets.build(m_broker, std::string(sc_module::name()) + ".");
+            m_presets_valid = true;
+        }
+        return m_presets;
+    }
+
+    void invalidate_presets()
+    {
+        m_presets.clear();
+        m_presets_valid = false;
+    }
+
 public:
     SCP_LOGGER(());
 
@@ -258,7 +277,7 @@ public:
      */
     void name_bind(sc_core::sc_module* m)
     {
-        for (auto param : sc_cci_children(m->name())) {
+        for (auto param : (m_presets_valid ? m_presets.children(m->name()) : sc_cci_children(m->name()))) {
             /* We should have a param like
              *  foo = &a.baa
              * foo should relate to an object in this model. a.b.bar should relate to an other
@@ -412,15 +431,11 @@ public:
         if (params_cache_it != m_moduletype_params_cache.end()) {
             all_params = params_cache_it->second;
         } else {
-            auto params_range = m_broker.get_unconsumed_preset_values(
-                [&container_full_name](const std::pair<std::string, cci::cci_value>& iv) {
-                    return iv.first.find(container_full_name + ".") == 0 &&
-                           iv.first.find(".moduletype") != std::string::npos &&
-                           iv.first.find(".moduletype") == iv.first.length() - 11;
-                });
-            for (const auto& param : params_range) {
-                all_params.push_back(param);
-            }
+            presets().for_each(container_full_name, [&all_params](const std::string& n, const cci::cci_value& v) {
+                if (n.find(".moduletype") != std::string::npos && n.find(".moduletype") == n.length() - 11) {
+                    all_params.emplace_back(n, v);
+                }
+            });
             m_moduletype_params_cache[container_full_name] = all_params;
         }
 
@@ -512,11 +527,10 @@ public:
 
             if (child_is_container) {
                 // Get bind parameters for this container child
-                auto child_params = m_broker.get_unconsumed_preset_values(
-                    [&child_config_name](const std::pair<std::string, cci::cci_value>& iv) {
-                        return iv.first.find(child_config_name + ".") == 0 &&
-                               iv.first.find(".bind") != std::string::npos;
-                    });
+                std::vector<std::pair<std::string, cci::cci_value>> child_params;
+                presets().for_each(child_config_name, [&child_params](const std::string& n, const cci::cci_value& v) {
+                    if (n.find(".bind") != std::string::npos) child_params.emplace_back(n, v);
+                });
 
                 for (const auto& param : child_params) {
                     if (param.second.is_string()) {
@@ -560,14 +574,13 @@ public:
         }
 
         // Check the container's own bind parameters (outside config table)
-        auto container_params = m_broker.get_unconsumed_preset_values(
-            [&container_full_name](const std::pair<std::string, cci::cci_value>& iv) {
-                std::string param_name = iv.first;
-                // Match pattern: container_full_name.<param>.bind but not container_full_name.config.*
-                return param_name.find(container_full_name + ".") == 0 &&
-                       param_name.find(".config.") == std::string::npos &&
-                       param_name.find(".bind") != std::string::npos;
-            });
+        std::vector<std::pair<std::string, cci::cci_value>> container_params;
+        presets().for_each(container_full_name, [&container_params](const std::string& n, const cci::cci_value& v) {
+            // Match pattern: container_full_name.<param>.bind but not container_full_name.config.*
+            if (n.find(".config.") == std::string::npos && n.find(".bind") != std::string::npos) {
+                container_params.emplace_back(n, v);
+            }
+        });
 
         for (const auto& param : container_params) {
             if (param.second.is_string()) {
@@ -675,16 +688,8 @@ public:
 
             std::string mod_full_path = module_name + "." + mod;
 
-            // Query broker for this module's parameters
-            auto mod_params = m_broker.get_unconsumed_preset_values(
-                [&mod_full_path](const std::pair<std::string, cci::cci_value>& iv) {
-                    return iv.first.find(mod_full_path + ".") == 0;
-                });
-
-            for (const auto& param : mod_params) {
-                const std::string& param_name = param.first;
-                const cci::cci_value& param_value = param.second;
-
+            // Look up this module's parameters
+            presets().for_each(mod_full_path, [&](const std::string& param_name, const cci::cci_value& param_value) {
                 if (param_name.length() > 5 && param_name.substr(param_name.length() - 5) == ".bind") {
                     if (param_value.is_string()) {
                         std::string bind_target = param_value.get_string();
@@ -694,12 +699,11 @@ public:
                                 (ref_path.length() > target_full_path.length() &&
                                  ref_path.substr(0, target_full_path.length() + 1) == target_full_path + ".")) {
                                 modules_that_reference_target.insert(mod);
-                                break;
                             }
                         }
                     }
                 }
-            }
+            });
         }
 
         // Cache the result
@@ -730,7 +734,9 @@ public:
         std::list<std::string> all_modules;
         std::string module_name = std::string(sc_module::name());
 
-        all_modules = gs::sc_cci_children(name());
+        // Index the presets once, nothing is constructed (and so consumed) until we return
+        invalidate_presets();
+        all_modules = presets().children(module_name);
 
         for (auto it = all_modules.begin(); it != all_modules.end();) {
             std::string mod_type_name = module_name + "." + *it + ".moduletype";
@@ -759,8 +765,9 @@ public:
 
                 m_per_pass_nested_deps_cache.clear();
 
-                std::map<std::string, std::set<std::string>> depends_on_me;
+                std::map<std::string, std::set<std::string>> depends_on; // module -> modules it waits for
                 std::map<std::string, std::set<std::string>> bind_reverse_index;
+                std::set<std::string> todo_set(todo.begin(), todo.end());
 
                 for (const auto& source_mod : todo) {
                     if (is_container_type(source_mod)) {
@@ -777,16 +784,13 @@ public:
                     }
                     bool source_is_router = (source_modtype.find("router") != std::string::npos ||
                                              source_modtype.find("Router") != std::string::npos);
+                    // Only router binds are tracked below
+                    if (!source_is_router) {
+                        continue;
+                    }
 
-                    auto mod_params = m_broker.get_unconsumed_preset_values(
-                        [&source_full_path](const std::pair<std::string, cci::cci_value>& iv) {
-                            return iv.first.find(source_full_path + ".") == 0;
-                        });
-
-                    for (const auto& param : mod_params) {
-                        const std::string& param_name = param.first;
-                        const cci::cci_value& param_value = param.second;
-
+                    presets().for_each(source_full_path, [&](const std::string& param_name,
+                                                             const cci::cci_value& param_value) {
                         if (param_name.length() > 5 && param_name.substr(param_name.length() - 5) == ".bind") {
                             if (param_value.is_string()) {
                                 std::string bind_target = param_value.get_string();
@@ -806,14 +810,13 @@ public:
                                     }
 
                                     // Only track bind dependencies for router modules
-                                    if (source_is_router &&
-                                        std::find(todo.begin(), todo.end(), target_mod) != todo.end()) {
+                                    if (source_is_router && todo_set.count(target_mod)) {
                                         bind_reverse_index[target_mod].insert(source_mod);
                                     }
                                 }
                             }
                         }
-                    }
+                    });
                 }
 
                 for (const auto& mod : todo) {
@@ -843,8 +846,8 @@ public:
                             if (dot_pos != std::string::npos) {
                                 sibling_name = sibling_name.substr(0, dot_pos);
                             }
-                            if (std::find(todo.begin(), todo.end(), sibling_name) != todo.end()) {
-                                depends_on_me[sibling_name].insert(mod);
+                            if (todo_set.count(sibling_name)) {
+                                depends_on[mod].insert(sibling_name);
                             }
                         }
                     }
@@ -852,7 +855,7 @@ public:
                     auto bind_it = bind_reverse_index.find(mod);
                     if (bind_it != bind_reverse_index.end()) {
                         for (const auto& bind_source : bind_it->second) {
-                            depends_on_me[mod].insert(bind_source);
+                            depends_on[bind_source].insert(mod);
                         }
                     }
                 }
@@ -864,11 +867,9 @@ public:
 
                     bool bind_deps_ready = true;
                     if (deps_available && enforce_bind_deps) {
-                        for (const auto& dep_pair : depends_on_me) {
-                            const std::string& required_module = dep_pair.first;
-                            const std::set<std::string>& modules_depending_on_it = dep_pair.second;
-
-                            if (modules_depending_on_it.count(name) > 0) {
+                        auto req_it = depends_on.find(name);
+                        if (req_it != depends_on.end()) {
+                            for (const auto& required_module : req_it->second) {
                                 if (done.count(required_module) == 0) {
                                     bind_deps_ready = false;
                                     break;
@@ -995,9 +996,13 @@ public:
             }
         }
 
+        // Construction consumed some presets, index what is left once for all the binds
+        invalidate_presets();
+        presets();
         for (auto mod : m_allModules) {
             name_bind(mod);
         }
+        invalidate_presets();
         SCP_DEBUG(())("ModulesConstruct complete");
     }
 
@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PARALLEL_CLUSTERS_H
+#define PARALLEL_CLUSTERS_H
+
+#ifndef _WIN32
+
+#ifndef SC_INCLUDE_DYNAMIC_PROCESSES
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <systemc>
+#include <scp/report.h>
+
+#include <sync_window_shm.h>
+
+namespace gs {
+
+/**
+ * @brief Receiving end of the links of one cluster: messages handed over by
+ * the synchronisation reader thread are delivered on the SystemC thread, at
+ * their time stamp.
+ */
+class parallel_clusters_mailbox : public sc_core::sc_module, public sc_core::sc_prim_channel
+{
+public:
+    using receive_cb = std::function<void(int from, uint64_t data)>;
+
+private:
+    struct message {
+        int from;
+        uint64_t data;
+    };
+
+    /* Filled by the reader thread */
+    std::mutex m_mutex;
+    std::vector<std::pair<sc_core::sc_time, message>> m_incoming;
+
+    std::multimap<sc_core::sc_time, message> m_pending;
+    sc_core::sc_event m_deliver_ev;
+    receive_cb m_cb;
+    uint64_t m_received = 0;
+    uint64_t m_late = 0;
+
+    void update() override
+    {
+        std::vector<std::pair<sc_core::sc_time, message>> incoming;
+        {
+            std::lock_guard<std::mutex> lg(m_mutex);
+            incoming.swap(m_incoming);
+        }
+
+        sc_core::sc_time now = sc_core::sc_time_stamp();
+        for (auto& m : incoming) {
+            if (m.first < now) {
+                /* the sender did not leave us enough time, deliver at once */
+                m_late++;
+                m.first = now;
+            }
+            m_pending.emplace(m.first, m.second);
+        }
+        if (!m_pending.empty()) m_deliver_ev.notify(m_pending.begin()->first - now);
+    }
+
+    void deliver()
+    {
+        sc_core::sc_time now = sc_core::sc_time_stamp();
+        while (!m_pending.empty() && m_pending.begin()->first <= now) {
+            message m = m_pending.begin()->second;
+            m_pending.erase(m_pending.begin());
+            m_received++;
+            if (m_cb) m_cb(m.from, m.data);
+        }
+        if (!m_pending.empty()) m_deliver_ev.notify(m_pending.begin()->first - now);
+    }
+
+public:
+    SC_CTOR (parallel_clusters_mailbox) {
+        SC_METHOD(deliver);
+        dont_initialize();
+        sensitive << m_deliver_ev;
+    }
+
+    void register_receive_cb(receive_cb cb) { m_cb = cb; }
+
+    /* From any thread */
+    void push(const sc_core::sc_time& stamp, int from, uint64_t data)
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        m_incoming.push_back({ stamp, { from, data } });
+        async_request_update();
+    }
+
+    uint64_t get_received() const { return m_received; }
+    uint64_t get_late() const { return m_late; }
+};
+
+/**
+ * @brief Runs independent groups of modules (clusters) in parallel, each in
+ * its own SystemC kernel, exchanging time stamped messages.
+ *
+ * SystemC has a single kernel per process, so each cluster is placed in its
+ * own process: the constructor forks count-1 children, and each process then
+ * configures and builds only the cluster whose index() it was given, e.g. a
+ * Container loaded from the configuration of that cluster.
+ *
+ * The kernels are kept within one quantum of each other by a shared memory
+ * sc_sync_window group. Clusters communicate through send(), which delivers a
+ * value to the other cluster's receive callback link_latency() later in
+ * simulated time. The latency must exceed the quantum, which makes the
+ * delivery deterministic: the receiving cluster can not have passed the time
+ * stamp when the message reaches it.
+ *
+ * Modules of different clusters can not be bound to each other, send() is
+ * the only link between them.
+ *
+ * The constructor must run first thing in sc_main, before the logger, the
+ * broker or any other SystemC object is created: only the calling thread
+ * survives a fork, and each cluster elaborates its own kernel.
+ *
+ *   gs::parallel_clusters<> clusters(n);
+ *   scp::LoggingGuard logging_guard(...);
+ *   gs::ConfigurableBroker broker;
+ *   build_cluster(clusters.index());
+ *   clusters.register_receive_cb(...);
+ *   clusters.run(sc_core::sc_time(1, sc_core::SC_MS));
+ *   return clusters.wait();
+ */
+template <class sc_sync_policy = sc_core::sc_sync_policy_tlm_quantum>
+class parallel_clusters
+{
+    SCP_LOGGER((), "parallel_clusters");
+
+    static constexpr uint32_t LINK_SLOTS = 256;
+
+    struct link_message {
+        uint64_t stamp;
+        uint64_t data;
+    };
+
+    /* Single producer, single consumer ring from one cluster to another */
+    struct alignas(64) link_ring {
+        std::atomic<uint32_t> head;
+        std::atomic<uint32_t> sender_waiting;
+        alignas(64) std::atomic<uint32_t> tail;
+        alignas(64) link_message slots[LINK_SLOTS];
+    };
+
+    struct alignas(64) cluster_state {
+        std::atomic<uint32_t> done;
+    };
+
+    int m_index = 0;
+    int m_count;
+    std::string m_shm_name;
+    std::vector<pid_t> m_children;
+
+    /* Shared by all the processes, mapped before forking */
+    void* m_links_area = MAP_FAILED;
+    size_t m_links_size;
+    cluster_state* m_states = nullptr;
+    link_ring* m_rings = nullptr;
+
+    sc_core::sc_time m_latency = sc_core::SC_ZERO_TIME;
+    parallel_clusters_mailbox::receive_cb m_receive_cb;
+
+    std::unique_ptr<sc_core::sc_sync_window<sc_sync_policy>> m_window;
+    std::unique_ptr<sc_core::sc_sync_window_shm_group<sc_sync_policy>> m_group;
+    std::unique_ptr<parallel_clusters_mailbox> m_mailbox;
+
+    link_ring& ring(int from, int to) { return m_rings[from * m_count + to]; }
+
+    /* On the reader thread of the synchronisation group */
+    void receive()
+    {
+        for (int from = 0; from < m_count; from++) {
+            if (from == m_index) continue;
+            link_ring& r = ring(from, m_index);
+            uint32_t head = r.head.load(std::memory_order_relaxed);
+            uint32_t tail = r.tail.load(std::memory_order_acquire);
+            for (; head != tail; head++) {
+                const link_message& m = r.slots[head % LINK_SLOTS];
+                m_mailbox->push(sc_core::sc_time::from_value(m.stamp), from, m.data);
+            }
+            r.head.store(head, std::memory_order_release);
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (r.sender_waiting.load(std::memory_order_relaxed)) {
+                sc_core::sync_window_shm::futex_wake(&r.head);
+            }
+        }
+    }
+
+    /* Threads of this process, 0 if it can not be told */
+    static size_t thread_count()
+    {
+        DIR* dir = opendir("/proc/self/task");
+        if (!dir) return 0;
+        size_t n = 0;
+        while (struct dirent* e = readdir(dir)) {
+            if (e->d_name[0] != '.') n++;
+        }
+        closedir(dir);
+        return n;
+    }
+
+public:
+    parallel_clusters(int count, const std::string& name = "parallel_clusters")
+        : m_count(count), m_shm_name("/" + name + "_" + std::to_string(getpid()))
+    {
+        /* Nothing is configured yet, not even the logger */
+        if (count < 1 || size_t(count) > sc_core::sc_sync_window_shm_group_area::MAX_PARTICIPANTS) {
+            SC_REPORT_FATAL("parallel_clusters", "invalid number of clusters");
+        }
+        if (thread_count() > 1) {
+            SC_REPORT_FATAL("parallel_clusters", "must be constructed before any thread is started");
+        }
+        if (!sc_core::sc_get_top_level_objects().empty()) {
+            SC_REPORT_FATAL("parallel_clusters", "must be constructed before any SystemC object");
+        }
+
+        /* Zero filled, which is a valid state for all the atomics */
+        m_links_size = sizeof(cluster_state) * count + sizeof(link_ring) * count * count;
+        m_links_area = mmap(nullptr, m_links_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (m_links_area == MAP_FAILED) {
+            std::string err = "unable to map the cluster links: " + std::string(std::strerror(errno));
+            SC_REPORT_FATAL("parallel_clusters", err.c_str());
+        }
+        m_states = static_cast<cluster_state*>(m_links_area);
+        m_rings = reinterpret_cast<link_ring*>(m_states + count);
+
+        std::fflush(nullptr);
+        for (int i = 1; i < count; i++) {
+            pid_t pid = fork();
+            if (pid == -1) {
+                std::string err = "unable to fork a cluster: " + std::string(std::strerror(errno));
+                SC_REPORT_FATAL("parallel_clusters", err.c_str());
+            }
+            if (pid == 0) {
+                m_index = i;
+                m_children.clear();
+                break;
+            }
+            m_children.push_back(pid);
+        }
+    }
+
+    parallel_clusters(const parallel_clusters&) = delete;
+    parallel_clusters& operator=(const parallel_clusters&) = delete;
+
+    /* Index of the cluster to build in this process, 0 in the original process */
+    int index() const { return m_index; }
+    int count() const { return m_count; }
+    bool is_main() const { return m_index == 0; }
+
+    /*
+     * Simulated time between a send() and the delivery, must exceed the
+     * quantum. Defaults to twice the quantum. Set before bind().
+     */
+    void set_link_latency(const sc_core::sc_time& latency) { m_latency = latency; }
+    sc_core::sc_time link_latency() const { return m_latency; }
+
+    /* Called on the SystemC thread for each message sent to this cluster. Set before bind(). */
+    void register_receive_cb(parallel_clusters_mailbox::receive_cb cb) { m_receive_cb = cb; }
+
+    /*
+     * Join the synchronisation group, during elaboration. Called by run() if
+     * not done before.
+     */
+    void bind()
+    {
+        if (m_mailbox) return;
+        SCP_DEBUG(())("Cluster {} of {} in process {}", m_index, m_count, getpid());
+
+        sc_core::sc_time quantum = sc_sync_policy().quantum();
+        if (m_latency == sc_core::SC_ZERO_TIME) m_latency = 2 * quantum;
+        if (m_latency <= quantum) {
+            SCP_FATAL(())("The link latency ({}) must exceed the quantum ({})", m_latency.to_string(),
+                          quantum.to_string());
+        }
+
+        m_mailbox = std::make_unique<parallel_clusters_mailbox>(
+            sc_core::sc_module_name(("cluster_mailbox_" + std::to_string(m_index)).c_str()));
+        m_mailbox->register_receive_cb(m_receive_cb);
+
+        if (m_count < 2) return;
+        m_window = std::make_unique<sc_core::sc_sync_window<sc_sync_policy>>(
+            sc_core::sc_module_name(("cluster_sync_" + std::to_string(m_index)).c_str()));
+        m_group = std::make_unique<sc_core::sc_sync_window_shm_group<sc_sync_policy>>(*m_window, m_shm_name,
+                                                                                         m_index, m_count);
+        m_group->register_receive_cb([this]() { receive(); });
+    }
+
+    /*
+     * Send data to cluster 'to', from the SystemC thread of this cluster. It
+     * is delivered there link_latency() from now. Messages sent to a cluster
+     * which finished are dropped.
+     */
+    void send(int to, uint64_t data)
+    {
+        sc_assert(to >= 0 && to < m_count);
+        sc_core::sc_time stamp = sc_core::sc_time_stamp() + m_latency;
+        if (to == m_index) {
+            m_mailbox->push(stamp, m_index, data);
+            return;
+        }
+
+        link_ring& r = ring(m_index, to);
+        uint32_t tail = r.tail.load(std::memory_order_relaxed);
+        uint32_t head;
+        while (tail - (head = r.head.load(std::memory_order_acquire)) >= LINK_SLOTS) {
+            /*
+             * The reader thread of the destination drains the ring whatever
+             * its kernel does, sleep until it moved the head.
+             */
+            if (m_states[to].done.load(std::memory_order_acquire)) return;
+            r.sender_waiting.store(1, std::memory_order_seq_cst);
+            m_group->notify();
+            sc_core::sync_window_shm::futex_wait(&r.head, head);
+            r.sender_waiting.store(0, std::memory_order_relaxed);
+        }
+        r.slots[tail % LINK_SLOTS] = { stamp.value(), data };
+        r.tail.store(tail + 1, std::memory_order_release);
+        m_group->notify();
+    }
+
+    /*
+     * Simulate this cluster for the given duration, then release the others so
+     * they can finish too.
+     */
+    void run(const sc_core::sc_time& duration)
+    {
+        bind();
+        sc_core::sc_spawn(
+            [this, duration]() {
+                sc_core::wait(duration);
+                m_states[m_index].done.store(1, std::memory_order_release);
+                if (m_window) m_window->detach();
+                sc_core::sc_stop();
+            },
+            "cluster_end");
+        sc_core::sc_start();
+    }
+
+    /* Messages delivered to this cluster, and how many of them after their time stamp */
+    uint64_t get_received() const { return m_mailbox ? m_mailbox->get_received() : 0; }
+    uint64_t get_late() const { return m_mailbox ? m_mailbox->get_late() : 0; }
+
+    /* Lag statistics of cluster i, as seen from this process */
+    sc_core::sc_sync_window_lag_stats get_stats(int i)
+    {
+        return m_group ? m_group->get_stats(i) : sc_core::sc_sync_window_lag_stats();
+    }
+
+    /*
+     * In the main process, wait for all the other clusters and return 0 if
+     * they all exited successfully. In the others, returns 0.
+     */
+    int wait()
+    {
+        int ret = 0;
+        for (pid_t child : m_children) {
+            int status = 0;
+            if (waitpid(child, &status, 0) != child || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                SCP_WARN(())("Cluster process {} failed", child);
+                ret = 1;
+            }
+        }
+        m_children.clear();
+        return ret;
+    }
+
+    ~parallel_clusters()
+    {
+        if (m_states) m_states[m_index].done.store(1, std::memory_order_release);
+        m_group.reset();
+        wait();
+        if (m_links_area != MAP_FAILED) munmap(m_links_area, m_links_size);
+    }
+};
+
+} // namespace gs
+
+#endif // _WIN32
+#endif // PARALLEL_CLUSTERS_H
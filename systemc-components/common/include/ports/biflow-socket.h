@@ -281,6 +281,21 @@ public:
         m_send_event.notify();
     }
 
+    /**
+     * @brief enqueue
+     * Enqueue a block of data to be sent, it goes out in as few transactions as the other side allows.
+     * NOTE: Thread safe.
+     * @param data
+     * @param len number of items
+     */
+    void enqueue(const T* data, size_t len)
+    {
+        SCP_TRACE(())("Sending {} items", len);
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_queue.insert(m_queue.end(), data, data + len);
+        m_send_event.notify();
+    }
+
     /**
      * @brief set_default_txn
      * set transaction parameters (command, address and data_length)
@@ -497,6 +512,7 @@ public:
     void can_receive_any() { main_socket.can_receive_any(); }
 
     void enqueue(T data) { main_socket.enqueue(data); }
+    void enqueue(const T* data, size_t len) { main_socket.enqueue(data, len); }
 
     void set_default_txn(tlm::tlm_generic_payload& txn) { main_socket.set_default_txn(txn); }
 
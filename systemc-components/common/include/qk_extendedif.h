@@ -30,6 +30,11 @@ namespace SyncPolicy {
 enum Type { SYSTEMC_THREAD, OS_THREAD };
 }
 
+/* Kinds of interaction between an initiator and the rest of the simulation */
+namespace QkInteraction {
+enum Type { MMIO, IRQ, DMI_INVALIDATE, NUM_TYPES };
+}
+
 class tlm_quantumkeeper_extended : public tlm_utils::tlm_quantumkeeper, public sc_core::sc_object
 {
 public:
@@ -68,6 +73,10 @@ public:
         return tlm_utils::tlm_quantumkeeper::need_sync();
     }
 
+    // called by the initiator each time it interacts with the rest of the
+    // simulation, for policies adapting to the I/O rate
+    virtual void record_interaction(QkInteraction::Type type) {}
+
     // NB, the following function is only for the convenience of
     // the 'old' sync policys. This can/should be removed.
     virtual void run_on_systemc(std::function<void()> job) { job(); }
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef QKMULTI_ADAPTIVE_RATE_H
+#define QKMULTI_ADAPTIVE_RATE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+#include <cci_configuration>
+
+#include <qkmultithread.h>
+
+namespace gs {
+/*
+ * Multithread QK whose synchronisation window follows the observed interaction
+ * rate of its initiator (MMIO accesses, interrupts, DMI invalidations).
+ *
+ * Once per window of local time, the number of interactions per global
+ * quantum is computed. Above high_rate, the initiator is I/O bound: the window
+ * is halved so that it stays close to SystemC. Below low_rate, it is compute
+ * bound: the window is doubled so that it syncs less often. The window always
+ * stays within [min_quantum_ns, max_quantum_ns], which default to 1/2 and 8
+ * times the global quantum.
+ */
+class tlm_quantumkeeper_multi_adaptive_rate : public tlm_quantumkeeper_multithread
+{
+    cci::cci_param<uint64_t> p_min_quantum_ns;
+    cci::cci_param<uint64_t> p_max_quantum_ns;
+    cci::cci_param<double> p_low_rate;
+    cci::cci_param<double> p_high_rate;
+
+    std::atomic<uint64_t> m_interactions[QkInteraction::NUM_TYPES];
+
+    /* Written by the initiator thread, read by SystemC for the status */
+    std::atomic<uint64_t> m_window_ns{ 0 };
+    std::atomic<uint64_t> m_widened{ 0 };
+    std::atomic<uint64_t> m_narrowed{ 0 };
+    std::atomic<double> m_last_rate{ 0 };
+
+    /* Written by reset() on the SystemC thread, and by adapt() on the initiator thread */
+    std::mutex m_period_mutex;
+    sc_core::sc_time m_period_start;
+    uint64_t m_period_interactions = 0;
+
+    sc_core::sc_time quantum() const { return tlm_utils::tlm_quantumkeeper::get_global_quantum(); }
+
+    uint64_t min_ns() const
+    {
+        return p_min_quantum_ns ? p_min_quantum_ns.get_value() : uint64_t(quantum().to_seconds() * 1e9 / 2);
+    }
+
+    uint64_t max_ns() const
+    {
+        return p_max_quantum_ns ? p_max_quantum_ns.get_value() : uint64_t(quantum().to_seconds() * 1e9 * 8);
+    }
+
+    uint64_t total_interactions() const
+    {
+        uint64_t n = 0;
+        for (auto& i : m_interactions) n += i.load(std::memory_order_relaxed);
+        return n;
+    }
+
+    /* Called on the initiator thread at each sync */
+    void adapt()
+    {
+        std::lock_guard<std::mutex> lock(m_period_mutex);
+        sc_core::sc_time window(double(m_window_ns), sc_core::SC_NS);
+        sc_core::sc_time elapsed = m_local_time - m_period_start;
+        if (m_local_time < m_period_start || elapsed < window) {
+            return;
+        }
+
+        uint64_t total = total_interactions();
+        double rate = double(total - m_period_interactions) / (elapsed / quantum());
+        uint64_t w = m_window_ns;
+
+        if (rate > p_high_rate && w > min_ns()) {
+            w = std::max(w / 2, min_ns());
+            m_narrowed++;
+            SCP_DEBUG("Libgssync") << name() << ": " << rate << " interactions/quantum, narrowing to " << w << "ns";
+        } else if (rate < p_low_rate && w < max_ns()) {
+            w = std::min(w * 2, max_ns());
+            m_widened++;
+            SCP_DEBUG("Libgssync") << name() << ": " << rate << " interactions/quantum, widening to " << w << "ns";
+        }
+
+        m_window_ns = w;
+        m_last_rate = rate;
+        m_period_start = m_local_time;
+        m_period_interactions = total;
+    }
+
+public:
+    tlm_quantumkeeper_multi_adaptive_rate()
+        : p_min_quantum_ns(std::string(name()) + ".min_quantum_ns", 0,
+                           "Smallest synchronisation window in ns (0: half the global quantum)", cci::CCI_ABSOLUTE_NAME)
+        , p_max_quantum_ns(std::string(name()) + ".max_quantum_ns", 0,
+                           "Largest synchronisation window in ns (0: 8 times the global quantum)",
+                           cci::CCI_ABSOLUTE_NAME)
+        , p_low_rate(std::string(name()) + ".low_rate", 1.0,
+                     "Interactions per quantum under which the window is widened", cci::CCI_ABSOLUTE_NAME)
+        , p_high_rate(std::string(name()) + ".high_rate", 8.0,
+                      "Interactions per quantum above which the window is narrowed", cci::CCI_ABSOLUTE_NAME)
+    {
+        for (auto& i : m_interactions) i = 0;
+        /* Start with the same window as the multithread policy */
+        m_window_ns = std::min(std::max(uint64_t(quantum().to_seconds() * 1e9 * 2), min_ns()), max_ns());
+    }
+
+    virtual void record_interaction(QkInteraction::Type type) override
+    {
+        m_interactions[type].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    virtual sc_core::sc_time time_to_sync() override
+    {
+        if (status != RUNNING) return sc_core::SC_ZERO_TIME;
+
+        sc_core::sc_time q = sc_core::sc_time_stamp() + sc_core::sc_time(double(m_window_ns), sc_core::SC_NS);
+        sc_core::sc_time now = get_current_time();
+        if (q >= now) {
+            return q - now;
+        } else {
+            return sc_core::SC_ZERO_TIME;
+        }
+    }
+
+    virtual void sync() override
+    {
+        if (!is_sysc_thread()) {
+            adapt();
+        }
+        tlm_quantumkeeper_multithread::sync();
+    }
+
+    virtual void reset() override
+    {
+        tlm_quantumkeeper_multithread::reset();
+        std::lock_guard<std::mutex> lock(m_period_mutex);
+        m_period_start = m_local_time;
+        m_period_interactions = total_interactions();
+    }
+
+    sc_core::sc_time get_window() const { return sc_core::sc_time(double(m_window_ns), sc_core::SC_NS); }
+
+    virtual std::string get_status_json() override
+    {
+        std::string s = tlm_quantumkeeper_multithread::get_status_json();
+        char buf[512];
+        std::snprintf(buf, sizeof(buf),
+                      ",\"policy\":\"adaptive-rate\",\"window_ns\":%llu,\"min_ns\":%llu,\"max_ns\":%llu"
+                      ",\"interaction_rate\":%.3f,\"mmio\":%llu,\"irq\":%llu,\"dmi_invalidate\":%llu"
+                      ",\"widened\":%llu,\"narrowed\":%llu",
+                      (unsigned long long)m_window_ns.load(), (unsigned long long)min_ns(),
+                      (unsigned long long)max_ns(), m_last_rate.load(),
+                      (unsigned long long)m_interactions[QkInteraction::MMIO].load(),
+                      (unsigned long long)m_interactions[QkInteraction::IRQ].load(),
+                      (unsigned long long)m_interactions[QkInteraction::DMI_INVALIDATE].load(),
+                      (unsigned long long)m_widened.load(), (unsigned long long)m_narrowed.load());
+        /* insert before the closing brace */
+        return s.substr(0, s.size() - 1) + buf + "}";
+    }
+};
+} // namespace gs
+#endif // QKMULTI_ADAPTIVE_RATE_H
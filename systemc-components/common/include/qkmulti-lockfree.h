@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef QKMULTI_LOCKFREE_H
+#define QKMULTI_LOCKFREE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include <qkmultithread.h>
+
+namespace gs {
+/*
+ * Same synchronisation rules as tlm_quantumkeeper_multithread (stay within 2
+ * quanta of SystemC), without a shared mutex: the external thread publishes
+ * its local time in an atomic, the SystemC side publishes its own time in
+ * another one, and each side reads the other's without locking. SystemC is
+ * only kicked when it is actually suspended waiting for us, and an external
+ * thread running out of budget parks on a futex (a condition variable on
+ * hosts without futex) until SystemC publishes a new time.
+ */
+class tlm_quantumkeeper_multithread_lockfree : public tlm_quantumkeeper_multithread
+{
+    SCP_LOGGER();
+
+    /* Absolute times, in sc_time value units */
+    std::atomic<uint64_t> m_local_ticks{ 0 };
+    std::atomic<uint64_t> m_sc_ticks{ 0 };
+
+    /* Bumped each time SystemC publishes, external threads wait on it */
+    std::atomic<uint32_t> m_epoch{ 0 };
+    std::atomic<int> m_waiters{ 0 };
+
+    /* SystemC is suspended and needs a kick to look at our time again */
+    std::atomic<bool> m_sc_suspended{ false };
+
+    /* Only used on hosts without futex */
+    std::mutex m_park_mutex;
+    std::condition_variable m_park_cond;
+
+    /* Statistics */
+    std::atomic<uint64_t> m_syncs{ 0 };
+    std::atomic<uint64_t> m_parks{ 0 };
+    std::atomic<uint64_t> m_kicks{ 0 };
+
+    void publish_local() { m_local_ticks.store(m_local_time.value(), std::memory_order_release); }
+    void kick_systemc();
+    void publish_epoch();
+    void park(uint32_t epoch, std::chrono::milliseconds timeout);
+
+protected:
+    virtual void timehandler() override;
+    virtual void wake_external() override;
+
+public:
+    tlm_quantumkeeper_multithread_lockfree();
+
+    virtual sc_core::sc_time time_to_sync() override;
+
+    void inc(const sc_core::sc_time& t) override;
+    void set(const sc_core::sc_time& t) override;
+    virtual void sync() override;
+    void reset() override;
+    sc_core::sc_time get_current_time() const override;
+
+    uint64_t get_sync_count() const { return m_syncs.load(); }
+    uint64_t get_park_count() const { return m_parks.load(); }
+    uint64_t get_kick_count() const { return m_kicks.load(); }
+};
+} // namespace gs
+#endif // QKMULTI_LOCKFREE_H
@@ -14,19 +14,33 @@
 
 #include <systemc>
 
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
 #include <scp/report.h>
 
 #include <qkmulti-quantum.h>
-#include <semaphore.h>
 #include <libgsutils.h>
 
 namespace gs {
-class tlm_quantumkeeper_multi_rolling : public tlm_quantumkeeper_multi_quantum
+/*
+ * Budget is bounded by both the quantum boundary and the next pending SystemC
+ * event. The SystemC side publishes its time and the time of the next pending
+ * event after each update phase, so that external threads compute their budget
+ * without blocking on the kernel.
+ */
+class tlm_quantumkeeper_multi_rolling : public tlm_quantumkeeper_multi_quantum, public sc_core::sc_stage_callback_if
 {
 private:
-    async_event m_time_ev;
-    sc_core::sc_time m_next_time;
-    semaphore m_sem;
+    static constexpr uint64_t NO_EVENT = std::numeric_limits<uint64_t>::max();
+
+    /* Horizon published by SystemC, in sc_time value units, guarded by a seqlock */
+    std::atomic<uint32_t> m_seq{ 0 };
+    std::atomic<uint64_t> m_sc_ticks{ 0 };
+    std::atomic<uint64_t> m_next_event_ticks{ NO_EVENT };
+
+    std::atomic<uint64_t> m_horizon_updates{ 0 };
 
     sc_core::sc_time get_next_time()
     {
@@ -49,33 +63,89 @@ private:
         }
     }
 
-    void get_time_from_systemc()
+    /* SystemC side, the only writer */
+    void publish_horizon()
+    {
+        uint64_t now = sc_core::sc_time_stamp().value();
+        uint64_t next;
+        if (sc_core::sc_pending_activity_at_current_time()) {
+            next = now;
+        } else if (sc_core::sc_pending_activity_at_future_time()) {
+            next = now + sc_core::sc_time_to_pending_activity().value();
+        } else {
+            next = NO_EVENT;
+        }
+
+        if (now == m_sc_ticks.load(std::memory_order_relaxed) &&
+            next == m_next_event_ticks.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        uint32_t seq = m_seq.load(std::memory_order_relaxed);
+        m_seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_sc_ticks.store(now, std::memory_order_relaxed);
+        m_next_event_ticks.store(next, std::memory_order_relaxed);
+        m_seq.store(seq + 2, std::memory_order_release);
+        m_horizon_updates.fetch_add(1, std::memory_order_relaxed);
+
+        /* Nobody can make progress while there is activity at the current time */
+        if (next != now) {
+            notify_external();
+        }
+    }
+
+    /* External side, lock free */
+    void read_horizon(uint64_t& now, uint64_t& next) const
     {
-        m_next_time = get_next_time();
-        m_sem.notify();
+        uint32_t seq;
+        do {
+            seq = m_seq.load(std::memory_order_acquire);
+            now = m_sc_ticks.load(std::memory_order_relaxed);
+            next = m_next_event_ticks.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((seq & 1) || seq != m_seq.load(std::memory_order_relaxed));
     }
 
     virtual sc_core::sc_time time_to_sync() override
     {
-        if (is_sysc_thread())
-            return get_next_time();
-        else {
-            m_time_ev.notify();
-            m_sem.wait();
-            return m_next_time;
+        if (is_sysc_thread()) return get_next_time();
+
+        if (status != RUNNING) return sc_core::SC_ZERO_TIME;
+
+        uint64_t now, next;
+        read_horizon(now, next);
+        if (next == now) {
+            return sc_core::SC_ZERO_TIME;
         }
+
+        sc_core::sc_time quantum = tlm_utils::tlm_quantumkeeper::get_global_quantum();
+        sc_core::sc_time boundary = sc_core::sc_time::from_value(now) + quantum;
+        sc_core::sc_time local = get_current_time();
+        sc_core::sc_time quantum_boundary = (boundary > local) ? boundary - local : sc_core::SC_ZERO_TIME;
+        if (next == NO_EVENT) {
+            return quantum_boundary;
+        }
+        return std::min(sc_core::sc_time::from_value(next - now), quantum_boundary);
     }
 
 public:
-    tlm_quantumkeeper_multi_rolling(): m_time_ev(false)
+    tlm_quantumkeeper_multi_rolling()
     {
-        sc_core::sc_spawn_options opt;
-        opt.spawn_method();
-        opt.set_sensitivity(&m_time_ev);
-        opt.dont_initialize();
-        sc_core::sc_spawn(sc_bind(&tlm_quantumkeeper_multi_rolling::get_time_from_systemc, this), "get_time_from_sysc",
-                          &opt);
+        /* No budget until SystemC has published its first horizon */
+        m_sc_ticks = sc_core::sc_time_stamp().value();
+        m_next_event_ticks = m_sc_ticks.load();
+        sc_core::sc_register_stage_callback(*this, sc_core::SC_POST_UPDATE);
     }
+
+    virtual ~tlm_quantumkeeper_multi_rolling()
+    {
+        sc_core::sc_unregister_stage_callback(*this, sc_core::SC_POST_UPDATE);
+    }
+
+    void stage_callback(const sc_core::sc_stage& stage) override { publish_horizon(); }
+
+    uint64_t get_horizon_updates() const { return m_horizon_updates.load(); }
 };
 } // namespace gs
 #endif // QKMULTI_ROLLING_H
@@ -35,8 +35,14 @@ protected:
 
     virtual bool is_sysc_thread() const;
 
-private:
-    void timehandler();
+    /* SystemC side of the synchronisation, run each time m_tick fires */
+    virtual void timehandler();
+
+    /* Wake up external threads blocked in sync(), called once stopped */
+    virtual void wake_external() {}
+
+    /* Wake up external threads blocked in sync() so they re-evaluate their budget */
+    void notify_external();
 
 public:
     virtual ~tlm_quantumkeeper_multithread();
@@ -69,7 +75,7 @@ public:
 
     // this function provided only for debug.
     jobstates get_status() { return (jobstates)(status | (m_systemc_waiting << 2) | (m_extern_waiting << 3)); }
-    std::string get_status_json()
+    virtual std::string get_status_json()
     {
         std::string s = "\"name\":\"" + std::string(name()) + "\"";
         s = s + ",\"quantum_time\":\"" + std::string(get_local_time().to_string()) + "\"";
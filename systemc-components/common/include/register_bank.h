@@ -0,0 +1,501 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef GS_REGISTER_BANK_H
+#define GS_REGISTER_BANK_H
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <systemc>
+#include <cci_configuration>
+#include <tlm>
+#include <tlm_utils/simple_target_socket.h>
+#include <scp/report.h>
+#include <tlm_sockets_buswidth.h>
+#include <registers.h>
+
+namespace gs {
+
+/**
+ * @brief A register of a gs_register_bank, as seen by the bank: the range it occupies in the bank storage, and the
+ * handler for the bus accesses hitting that range.
+ */
+class gs_bank_register_handler
+{
+protected:
+    uint64_t m_offset;
+    uint64_t m_size;
+
+public:
+    gs_bank_register_handler(uint64_t offset, uint64_t size): m_offset(offset), m_size(size) {}
+    virtual ~gs_bank_register_handler() = default;
+
+    virtual void b_transport(tlm::tlm_generic_payload& txn, sc_core::sc_time& delay) = 0;
+    virtual std::string get_regname() const = 0;
+
+    uint64_t get_offset() const { return m_offset; }
+    uint64_t get_size() const { return m_size; }
+};
+
+/**
+ * @brief A block of registers behind a single target socket.
+ *
+ * Where every gs_register is a target socket, an initiator socket and a set of CCI parameters, reached through a
+ * reg_router and backed by a gs_memory, the registers of a gs_register_bank (gs_bank_register) are plain objects:
+ * their values live in one contiguous storage array owned by the bank, and the bank dispatches bus accesses to them
+ * using an offset->register table built once, at the end of elaboration (or on the first access after a register was
+ * added). The table is a direct table indexed by offset for blocks up to max_direct_entries slots, and a sorted array
+ * searched by bisection above that.
+ *
+ * Addresses seen on the target socket are offsets in the bank. Accesses which do not hit a register read and write
+ * the storage, like the reg_memory of a reg_router based model. An access must stay within one register, or within
+ * the storage between two registers: accesses crossing the boundary of a register get an address error.
+ *
+ * The bank must be constructed before its registers (e.g. declared before them in the model).
+ */
+class gs_register_bank : public sc_core::sc_module
+{
+    SCP_LOGGER(());
+
+    struct entry {
+        uint64_t offset;
+        uint64_t size;
+        gs_bank_register_handler* reg;
+    };
+
+    std::vector<unsigned char> m_storage;
+    std::vector<entry> m_entries;
+    /* (offset >> m_shift) -> index in m_entries + 1, 0 if no register */
+    std::vector<uint32_t> m_direct;
+    unsigned int m_shift = 0;
+    bool m_table_valid = false;
+
+    void build_table()
+    {
+        std::sort(m_entries.begin(), m_entries.end(),
+                  [](const entry& a, const entry& b) { return a.offset < b.offset; });
+        uint64_t granule = 0;
+        for (size_t i = 0; i < m_entries.size(); i++) {
+            if (i && m_entries[i].offset < m_entries[i - 1].offset + m_entries[i - 1].size) {
+                SCP_FATAL(()) << m_entries[i].reg->get_regname() << " overlaps with "
+                              << m_entries[i - 1].reg->get_regname();
+            }
+            granule |= m_entries[i].offset | m_entries[i].size;
+        }
+
+        /* Every register starts and ends on a multiple of 1 << m_shift, so a slot belongs to one register at most */
+        m_shift = 0;
+        while (granule && !(granule & (1ull << m_shift)) && m_shift < 3) m_shift++;
+
+        m_direct.clear();
+        uint64_t slots = (m_storage.size() + (1ull << m_shift) - 1) >> m_shift;
+        if (!m_entries.empty() && slots <= p_max_direct_entries.get_value()) {
+            m_direct.assign(slots, 0);
+            for (size_t i = 0; i < m_entries.size(); i++) {
+                uint64_t end = (m_entries[i].offset + m_entries[i].size) >> m_shift;
+                for (uint64_t s = m_entries[i].offset >> m_shift; s < end; s++) m_direct[s] = i + 1;
+            }
+        }
+        m_table_valid = true;
+        SCP_DEBUG(()) << m_entries.size() << " registers in 0x" << std::hex << m_storage.size() << " bytes, "
+                      << (m_direct.empty() ? "sorted" : "direct") << " lookup table";
+    }
+
+    gs_bank_register_handler* lookup(uint64_t offset)
+    {
+        if (!m_table_valid) build_table();
+        if (!m_direct.empty()) {
+            uint64_t slot = offset >> m_shift;
+            return (slot < m_direct.size() && m_direct[slot]) ? m_entries[m_direct[slot] - 1].reg : nullptr;
+        }
+        auto it = std::upper_bound(m_entries.begin(), m_entries.end(), offset,
+                                   [](uint64_t o, const entry& e) { return o < e.offset; });
+        if (it == m_entries.begin()) return nullptr;
+        --it;
+        return (offset - it->offset < it->size) ? it->reg : nullptr;
+    }
+
+    /* Whether [offset, offset + len) does not stay within reg, or within the gap it starts in if reg is null */
+    bool crosses_register(uint64_t offset, uint64_t len, gs_bank_register_handler* reg)
+    {
+        if (reg) return offset + len > reg->get_offset() + reg->get_size();
+        auto it = std::lower_bound(m_entries.begin(), m_entries.end(), offset,
+                                   [](const entry& e, uint64_t o) { return e.offset < o; });
+        return it != m_entries.end() && it->offset < offset + len;
+    }
+
+    bool check_txn(tlm::tlm_generic_payload& txn)
+    {
+        uint64_t addr = txn.get_address();
+        uint64_t len = txn.get_data_length();
+        if (txn.get_byte_enable_ptr()) {
+            txn.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+            return false;
+        }
+        if (txn.get_streaming_width() < len) {
+            txn.set_response_status(tlm::TLM_BURST_ERROR_RESPONSE);
+            return false;
+        }
+        if (addr >= m_storage.size() || len > m_storage.size() - addr) {
+            SCP_WARN(())("Attempt to access unknown register at offset 0x{:x}", addr);
+            txn.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+            return false;
+        }
+        return true;
+    }
+
+    void b_transport(tlm::tlm_generic_payload& txn, sc_core::sc_time& delay)
+    {
+        txn.set_dmi_allowed(false);
+        if (!check_txn(txn)) return;
+        gs_bank_register_handler* reg = lookup(txn.get_address());
+        if (crosses_register(txn.get_address(), txn.get_data_length(), reg)) {
+            SCP_WARN(())("Access at offset 0x{:x} of 0x{:x} bytes crosses a register boundary", txn.get_address(),
+                         txn.get_data_length());
+            txn.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+            return;
+        }
+        if (reg) {
+            reg->b_transport(txn, delay);
+        } else {
+            access(txn);
+        }
+    }
+
+    /* Debug accesses reach the storage only, as they reach the reg_memory only behind a reg_router */
+    unsigned int transport_dbg(tlm::tlm_generic_payload& txn)
+    {
+        if (!check_txn(txn)) return 0;
+        access(txn);
+        return txn.get_data_length();
+    }
+
+    bool get_direct_mem_ptr(tlm::tlm_generic_payload& txn, tlm::tlm_dmi& dmi_data) { return false; }
+
+public:
+    tlm_utils::simple_target_socket<gs_register_bank, DEFAULT_TLM_BUSWIDTH> target_socket;
+    cci::cci_param<uint64_t> p_max_direct_entries;
+    cci::cci_param<bool> p_register_params;
+
+    gs_register_bank(const sc_core::sc_module_name& nm, uint64_t size = 0)
+        : sc_core::sc_module(nm)
+        , m_storage(size, 0)
+        , target_socket("target_socket")
+        , p_max_direct_entries("max_direct_entries", 1 << 20,
+                               "Largest number of slots of the direct offset->register table, a sorted table is "
+                               "used for larger banks")
+        , p_register_params("register_params", false,
+                            "Create the CCI parameters of every register, rather than only for the registers which "
+                            "have a preset value or ask for them")
+    {
+        SCP_TRACE(())("Constructor");
+        target_socket.register_b_transport(this, &gs_register_bank::b_transport);
+        target_socket.register_transport_dbg(this, &gs_register_bank::transport_dbg);
+        target_socket.register_get_direct_mem_ptr(this, &gs_register_bank::get_direct_mem_ptr);
+    }
+
+    gs_register_bank() = delete;
+    gs_register_bank(const gs_register_bank&) = delete;
+
+    void add(gs_bank_register_handler& reg)
+    {
+        uint64_t end = reg.get_offset() + reg.get_size();
+        if (end > m_storage.size()) m_storage.resize(end, 0);
+        m_entries.push_back({ reg.get_offset(), reg.get_size(), &reg });
+        m_table_valid = false;
+    }
+
+    void remove(gs_bank_register_handler& reg)
+    {
+        m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+                                       [&reg](const entry& e) { return e.reg == &reg; }),
+                        m_entries.end());
+        m_table_valid = false;
+    }
+
+    /* Plain access to the storage, ignoring the registers */
+    void access(tlm::tlm_generic_payload& txn)
+    {
+        unsigned char* ptr = &m_storage[txn.get_address()];
+        switch (txn.get_command()) {
+        case tlm::TLM_READ_COMMAND:
+            memcpy(txn.get_data_ptr(), ptr, txn.get_data_length());
+            break;
+        case tlm::TLM_WRITE_COMMAND:
+            memcpy(ptr, txn.get_data_ptr(), txn.get_data_length());
+            break;
+        default:
+            break;
+        }
+        txn.set_response_status(tlm::TLM_OK_RESPONSE);
+    }
+
+    /* Load e.g. reset values into the storage */
+    void load(const void* data, uint64_t len, uint64_t offset = 0)
+    {
+        if (offset + len > m_storage.size()) m_storage.resize(offset + len, 0);
+        memcpy(&m_storage[offset], data, len);
+    }
+
+    unsigned char* data(uint64_t offset = 0) { return &m_storage[offset]; }
+    uint64_t size() const { return m_storage.size(); }
+    size_t num_registers() const { return m_entries.size(); }
+    scp::scp_logger_cache& logger() { return SCP_LOGGER_NAME(); }
+
+    void before_end_of_elaboration() override
+    {
+        if (!m_table_valid) build_table();
+    }
+};
+
+/**
+ * @brief A register living in a gs_register_bank. It has the C++ interface of gs_register (value and array access,
+ * operators, fields, masks, pre/post read/write callbacks), but no socket: its value is in the bank storage and the
+ * bank calls it directly for the bus accesses it decodes to it.
+ *
+ * Its CCI parameters (<bank>.<path>.number, .target_socket.address, .target_socket.size and .target_socket.mask) are
+ * only created if the bank register_params parameter is set, if the address or mask has a preset value, or when
+ * create_params() is called.
+ */
+template <class TYPE = uint32_t>
+class gs_bank_register : public gs_bank_register_handler, public gs_register_if<TYPE>
+{
+    scp::scp_logger_cache& SCP_LOGGER_NAME();
+
+    struct params {
+        cci::cci_param<uint64_t> p_number;
+        cci::cci_param<uint64_t> p_offset;
+        cci::cci_param<uint64_t> p_size;
+        cci::cci_param<TYPE> p_mask;
+
+        params(const std::string& prefix, gs_bank_register& reg)
+            : p_number(prefix + ".number", reg.m_number, "number of elements in this register",
+                       cci::CCI_ABSOLUTE_NAME)
+            , p_offset(prefix + ".target_socket.address", reg.m_offset, "Offset of this register",
+                       cci::CCI_ABSOLUTE_NAME)
+            , p_size(prefix + ".target_socket.size", reg.m_size, "size of this register", cci::CCI_ABSOLUTE_NAME)
+            , p_mask(prefix + ".target_socket.mask", reg.m_mask,
+                     " R/W mask, 0 means read only, and 1 means write/read", cci::CCI_ABSOLUTE_NAME)
+        {
+        }
+    };
+
+    gs_register_bank& m_bank;
+    std::string m_regname;
+    std::string m_path;
+    uint64_t m_number;
+    TYPE m_mask;
+    std::unique_ptr<params> m_params;
+    bool m_in_bank = false;
+
+    std::vector<tlm_fnct::TLMFUNC> m_pre_read_fncts;
+    std::vector<tlm_fnct::TLMFUNC> m_pre_write_fncts;
+    std::vector<tlm_fnct::TLMFUNC> m_post_read_fncts;
+    std::vector<tlm_fnct::TLMFUNC> m_post_write_fncts;
+    bool m_in_callback = false;
+
+    std::string param_prefix() const
+    {
+        return std::string(m_bank.name()) + "." + (m_path.empty() ? m_regname : m_path);
+    }
+
+    unsigned char* ptr(uint64_t idx) { return m_bank.data(m_offset + idx * sizeof(TYPE)); }
+
+    void run(std::vector<tlm_fnct::TLMFUNC>& fncts, tlm::tlm_generic_payload& txn, sc_core::sc_time& delay)
+    {
+        for (auto& cb : fncts) cb(txn, delay);
+    }
+
+    /* The storage part of a bus write: the register elements are written through the mask, and the data actually
+     * written is returned in the transaction, as a gs_register does. The bank only hands over accesses within the
+     * register. */
+    void write_masked(tlm::tlm_generic_payload& txn)
+    {
+        uint64_t addr = txn.get_address();
+        uint64_t len = txn.get_data_length();
+        if ((len == 0) || (len % sizeof(TYPE)) || ((addr - m_offset) % sizeof(TYPE))) {
+            SCP_FATAL(()) << "write to " << m_regname << ": txn data length should be n * sizeof(TYPE) where n >= 1";
+        }
+        unsigned char* data = txn.get_data_ptr();
+        unsigned char* dst = m_bank.data(addr);
+        for (uint64_t i = 0; i < len; i += sizeof(TYPE)) {
+            TYPE cur, val;
+            memcpy(&cur, dst + i, sizeof(TYPE));
+            memcpy(&val, data + i, sizeof(TYPE));
+            cur = (val & m_mask) | (cur & ~m_mask);
+            memcpy(dst + i, &cur, sizeof(TYPE));
+            memcpy(data + i, &cur, sizeof(TYPE));
+        }
+        txn.set_response_status(tlm::TLM_OK_RESPONSE);
+    }
+
+public:
+    gs_bank_register() = delete;
+    gs_bank_register(const gs_bank_register&) = delete;
+    gs_bank_register(gs_register_bank& bank, std::string _name, std::string path = "", uint64_t offset = 0,
+                     uint64_t number = 1, TYPE mask = gs_full_mask<TYPE>())
+        : gs_bank_register_handler(offset, sizeof(TYPE) * number)
+        , SCP_LOGGER_NAME()(bank.logger())
+        , m_bank(bank)
+        , m_regname(_name)
+        , m_path(path)
+        , m_number(number)
+        , m_mask(mask)
+    {
+        static_assert(std::is_unsigned<TYPE>::value, "Register types must be unsigned");
+        if (m_bank.p_register_params.get_value()) {
+            create_params();
+        } else {
+            cci::cci_broker_handle broker = cci::cci_get_broker();
+            std::string prefix = param_prefix() + ".target_socket.";
+            if (broker.has_preset_value(prefix + "address") || broker.has_preset_value(prefix + "mask")) {
+                create_params();
+            }
+        }
+        m_bank.add(*this);
+        m_in_bank = true;
+    }
+
+    ~gs_bank_register() { m_bank.remove(*this); }
+
+    /*
+     * Create the CCI parameters of this register. Preset values of the number and address are only taken into account
+     * when called from the constructor, before the register is added to the bank; they are locked afterwards.
+     */
+    void create_params()
+    {
+        if (m_params) return;
+        m_params = std::make_unique<params>(param_prefix(), *this);
+        if (!m_in_bank) {
+            m_number = m_params->p_number.get_value();
+            m_offset = m_params->p_offset.get_value();
+            m_size = sizeof(TYPE) * m_number;
+        } else if (m_params->p_offset.get_value() != m_offset || m_params->p_number.get_value() != m_number) {
+            SCP_WARN(()) << m_regname << ": address and number can not be changed once in the bank, ignored";
+        }
+        m_mask = m_params->p_mask.get_value();
+        m_params->p_mask.register_post_write_callback([this](auto ev) { m_mask = ev.new_value; });
+        m_params->p_number.lock();
+        m_params->p_offset.lock();
+        m_params->p_size.lock();
+    }
+
+    /* Called by the bank, for the bus accesses decoded to this register */
+    void b_transport(tlm::tlm_generic_payload& txn, sc_core::sc_time& delay) override
+    {
+        bool callbacks = !m_in_callback && (m_pre_read_fncts.size() || m_pre_write_fncts.size() ||
+                                            m_post_read_fncts.size() || m_post_write_fncts.size());
+        if (callbacks) {
+            m_in_callback = true;
+            if (txn.is_read()) run(m_pre_read_fncts, txn, delay);
+            if (txn.is_write()) run(m_pre_write_fncts, txn, delay);
+            m_in_callback = false;
+        }
+        if (txn.get_response_status() >= tlm::TLM_INCOMPLETE_RESPONSE) {
+            if (txn.is_write() && m_mask != gs_full_mask<TYPE>()) {
+                write_masked(txn);
+            } else {
+                m_bank.access(txn);
+            }
+        }
+        if (callbacks && txn.get_response_status() == tlm::TLM_OK_RESPONSE) {
+            m_in_callback = true;
+            if (txn.is_read()) run(m_post_read_fncts, txn, delay);
+            if (txn.is_write()) run(m_post_write_fncts, txn, delay);
+            m_in_callback = false;
+        }
+    }
+
+    void pre_read(tlm_fnct::TLMFUNC cb) { m_pre_read_fncts.push_back(cb); }
+    void pre_write(tlm_fnct::TLMFUNC cb) { m_pre_write_fncts.push_back(cb); }
+    void post_read(tlm_fnct::TLMFUNC cb) { m_post_read_fncts.push_back(cb); }
+    void post_write(tlm_fnct::TLMFUNC cb) { m_post_write_fncts.push_back(cb); }
+
+    void get(TYPE* dst, uint64_t idx = 0, uint64_t length = 1)
+    {
+        sc_assert(idx + length <= m_number);
+        memcpy(dst, ptr(idx), sizeof(TYPE) * length);
+    }
+
+    void set(TYPE* src, uint64_t idx = 0, uint64_t length = 1, bool use_mask = true)
+    {
+        sc_assert(idx + length <= m_number);
+        if (!use_mask || (m_mask == gs_full_mask<TYPE>())) {
+            memcpy(ptr(idx), src, sizeof(TYPE) * length);
+            return;
+        }
+        for (uint64_t i = 0; i < length; i++) {
+            TYPE cur;
+            memcpy(&cur, ptr(idx + i), sizeof(TYPE));
+            cur = (src[i] & m_mask) | (cur & ~m_mask);
+            memcpy(ptr(idx + i), &cur, sizeof(TYPE));
+        }
+    }
+
+    TYPE get_value() override
+    {
+        TYPE tmp;
+        memcpy(&tmp, ptr(0), sizeof(TYPE));
+        return tmp;
+    }
+    void set_value(TYPE value) override { set(&value); }
+
+    void operator=(TYPE value) { set_value(value); }
+    operator TYPE() { return get_value(); }
+
+    void operator=(gs_bank_register<TYPE>& other) { set_value(other.get_value()); }
+    void operator+=(TYPE other) { set_value(get_value() + other); }
+    void operator-=(TYPE other) { set_value(get_value() - other); }
+    void operator/=(TYPE other)
+    {
+        if (other == 0) SCP_FATAL(())("Trying to divide a register value by 0!");
+        set_value(get_value() / other);
+    }
+    void operator*=(TYPE other) { set_value(get_value() * other); }
+    void operator&=(TYPE other) { set_value(get_value() & other); }
+    void operator|=(TYPE other) { set_value(get_value() | other); }
+    void operator^=(TYPE other) { set_value(get_value() ^ other); }
+    void operator<<=(TYPE other) { set_value(get_value() << other); }
+    void operator>>=(TYPE other) { set_value(get_value() >> other); }
+
+    gs_register_element<TYPE> operator[](int idx)
+    {
+        if (m_mask != gs_full_mask<TYPE>()) {
+            SCP_FATAL(()) << "operator[](): Register Mask: 0x" << std::hex << m_mask
+                          << " has readonly bits, please use set(TYPE* src, uint64_t idx, uint64_t length) and "
+                             "get(TYPE* dst, uint64_t idx, uint64_t length) instead";
+        }
+        if ((m_offset % alignof(TYPE)) || (uint64_t)idx >= m_number) {
+            SCP_FATAL(()) << "operator[](): " << m_regname << "[" << idx << "] is out of range or unaligned";
+        }
+        return gs_register_element<TYPE>(*reinterpret_cast<TYPE*>(ptr(idx)));
+    }
+    gs_bitfield<TYPE> operator[](gs_field<TYPE>& f) { return gs_bitfield<TYPE>(*this, f); }
+
+    std::string get_regname() const override { return m_regname; }
+    std::string get_path() const { return m_path; }
+    uint64_t get_offset() const { return m_offset; }
+    uint64_t get_size() const { return m_size; }
+    void set_mask(TYPE mask) // mask is allowed to be set to implement e.g. write-once semantics
+    {
+        SCP_TRACE(()) << "Set Mask of " << m_regname << " to 0x" << std::hex << mask;
+        if (m_params) {
+            m_params->p_mask = mask;
+        } else {
+            m_mask = mask;
+        }
+    }
+    TYPE get_mask() const { return m_mask; }
+};
+
+} // namespace gs
+
+#endif // GS_REGISTER_BANK_H
@@ -64,6 +64,7 @@ class port_fnct : public tlm_utils::simple_target_socket<port_fnct, DEFAULT_TLM_
     std::vector<std::shared_ptr<tlm_fnct>> m_post_write_fncts;
     cci::cci_param<bool> p_is_callback;
     bool m_in_callback = false;
+    bool m_dmi_granted = false;
 
     std::function<unsigned int(tlm::tlm_generic_payload&)> transport_dbg_func;
 
@@ -84,10 +85,29 @@ class port_fnct : public tlm_utils::simple_target_socket<port_fnct, DEFAULT_TLM_
             return 0;
     }
 
+    bool has_callbacks() const
+    {
+        return m_pre_read_fncts.size() || m_pre_write_fncts.size() || m_post_read_fncts.size() ||
+               m_post_write_fncts.size();
+    }
+
+    /*
+     * A register without callbacks and with a full mask is plain storage: the router in front of it may give DMI to the
+     * register memory. Masked registers get none, as initiators may not honour read only DMI (QEMU maps any DMI as
+     * RAM), their writes must go through b_transport. Only the granted access is filled in, the router provides the
+     * pointer and the address range.
+     */
+    bool get_direct_mem_ptr(tlm::tlm_generic_payload& txn, tlm::tlm_dmi& dmi_data)
+    {
+        if (has_callbacks() || is_write_masked()) return false;
+        dmi_data.allow_read_write();
+        m_dmi_granted = true;
+        return true;
+    }
+
     void b_transport(tlm::tlm_generic_payload& txn, sc_core::sc_time& delay)
     {
-        if (m_pre_read_fncts.size() || m_pre_write_fncts.size() || m_post_read_fncts.size() ||
-            m_post_write_fncts.size()) {
+        if (has_callbacks() || is_write_masked()) {
             if (!m_in_callback) {
                 m_in_callback = true;
                 switch (txn.get_response_status()) {
@@ -134,8 +154,8 @@ class port_fnct : public tlm_utils::simple_target_socket<port_fnct, DEFAULT_TLM_
                 }
                 m_in_callback = false;
             }
+            txn.set_dmi_allowed(false);
         }
-        txn.set_dmi_allowed(false);
     }
 
     /*template <typename T>
@@ -145,13 +165,40 @@ class port_fnct : public tlm_utils::simple_target_socket<port_fnct, DEFAULT_TLM_
         if (cbt) fn();
     }*/
 
+protected:
+    /* Withdraw the DMI given to the register memory, once accesses have to go through the callbacks or the mask */
+    void invalidate_dmi()
+    {
+        if (!m_dmi_granted) return;
+        m_dmi_granted = false;
+        SCP_DEBUG(())("Invalidate DMI: {}", my_name());
+        (*this)->invalidate_direct_mem_ptr(0, std::numeric_limits<sc_dt::uint64>::max());
+    }
+
 public:
-    void pre_read(tlm_fnct::TLMFUNC cb) { m_pre_read_fncts.push_back(std::make_shared<tlm_fnct>(cb)); }
-    void pre_write(tlm_fnct::TLMFUNC cb) { m_pre_write_fncts.push_back(std::make_shared<tlm_fnct>(cb)); }
-    void post_read(tlm_fnct::TLMFUNC cb) { m_post_read_fncts.push_back(std::make_shared<tlm_fnct>(cb)); }
-    void post_write(tlm_fnct::TLMFUNC cb) { m_post_write_fncts.push_back(std::make_shared<tlm_fnct>(cb)); }
+    void pre_read(tlm_fnct::TLMFUNC cb)
+    {
+        m_pre_read_fncts.push_back(std::make_shared<tlm_fnct>(cb));
+        invalidate_dmi();
+    }
+    void pre_write(tlm_fnct::TLMFUNC cb)
+    {
+        m_pre_write_fncts.push_back(std::make_shared<tlm_fnct>(cb));
+        invalidate_dmi();
+    }
+    void post_read(tlm_fnct::TLMFUNC cb)
+    {
+        m_post_read_fncts.push_back(std::make_shared<tlm_fnct>(cb));
+        invalidate_dmi();
+    }
+    void post_write(tlm_fnct::TLMFUNC cb)
+    {
+        m_post_write_fncts.push_back(std::make_shared<tlm_fnct>(cb));
+        invalidate_dmi();
+    }
     virtual void capture_txn_pre(tlm::tlm_generic_payload& txn) = 0;
     virtual void handle_mask_post(tlm::tlm_generic_payload& txn) = 0;
+    virtual bool is_write_masked() = 0;
 
     port_fnct() = delete;
     port_fnct(std::string name, std::string path_name)
@@ -166,6 +213,8 @@ public:
                                                                                                &port_fnct::b_transport);
         tlm_utils::simple_target_socket<port_fnct, DEFAULT_TLM_BUSWIDTH>::register_transport_dbg(
             this, &port_fnct::transport_dbg);
+        tlm_utils::simple_target_socket<port_fnct, DEFAULT_TLM_BUSWIDTH>::register_get_direct_mem_ptr(
+            this, &port_fnct::get_direct_mem_ptr);
     }
 
     void register_transport_dbg_func(std::function<unsigned int(tlm::tlm_generic_payload&)> fn)
@@ -187,6 +236,9 @@ class proxy_data_array
     scp::scp_logger_cache& SCP_LOGGER_NAME();
     TYPE* m_dmi = nullptr;
 
+    /* Small masked writes through the transport path use the stack for the read-modify-write */
+    static constexpr uint64_t MASKED_STACK_ELEMENTS = 16;
+
     void check_dmi()
     {
         tlm::tlm_generic_payload m_txn;
@@ -218,6 +270,10 @@ public:
 
     tlm_utils::simple_initiator_socket<proxy_data_array, DEFAULT_TLM_BUSWIDTH> initiator_socket;
 
+protected:
+    TYPE m_mask; // cached p_mask, read on every write
+
+public:
     void get(TYPE* dst, uint64_t idx = 0, uint64_t length = 1)
     {
         sc_assert(idx + length <= p_number);
@@ -249,8 +305,7 @@ public:
         sc_assert(idx + length <= p_number);
         if (m_dmi) {
             SCP_TRACE(())("Set value (DMI) : [{:#x}]", fmt::join(std::vector<TYPE>(&src[0], &src[length]), ","));
-            TYPE curr_val = m_dmi[idx];
-            if (!use_mask || (p_mask.get_value() == gs_full_mask<TYPE>())) {
+            if (!use_mask || (m_mask == gs_full_mask<TYPE>())) {
                 memcpy(&m_dmi[idx], src, sizeof(TYPE) * length);
             } else {
                 write_with_mask(src, reinterpret_cast<TYPE*>(&m_dmi[idx]), length);
@@ -258,14 +313,19 @@ public:
         } else {
             tlm::tlm_generic_payload m_txn;
             sc_core::sc_time dummy;
-            std::vector<unsigned char> curr_data;
-            if ((p_mask.get_value() == gs_full_mask<TYPE>()) || !use_mask) {
+            TYPE curr_stack[MASKED_STACK_ELEMENTS];
+            std::vector<TYPE> curr_heap;
+            if ((m_mask == gs_full_mask<TYPE>()) || !use_mask) {
                 m_txn.set_data_ptr(reinterpret_cast<unsigned char*>(src));
             } else {
-                curr_data.resize(sizeof(TYPE) * length);
-                get(reinterpret_cast<TYPE*>(curr_data.data()), idx, length);
-                write_with_mask(src, reinterpret_cast<TYPE*>(curr_data.data()), length);
-                m_txn.set_data_ptr(reinterpret_cast<unsigned char*>(curr_data.data()));
+                TYPE* curr_data = curr_stack;
+                if (length > MASKED_STACK_ELEMENTS) {
+                    curr_heap.resize(length);
+                    curr_data = curr_heap.data();
+                }
+                get(curr_data, idx, length);
+                write_with_mask(src, curr_data, length);
+                m_txn.set_data_ptr(reinterpret_cast<unsigned char*>(curr_data));
             }
             m_txn.set_byte_enable_length(0);
             m_txn.set_dmi_allowed(false);
@@ -291,16 +351,11 @@ public:
         if (!dst) {
             SCP_FATAL(())("write_with_mask(): dst pointer is NULL");
         }
-        std::vector<TYPE> mask_to_apply(length, p_mask.get_value());
-        std::vector<TYPE> new_and_mask(length, 0);     // result of *src & mask
-        std::vector<TYPE> old_and_not_mask(length, 0); // result of *dmi & ~mask
-        std::transform(src, src + length, mask_to_apply.cbegin(), new_and_mask.begin(),
-                       [](TYPE src_val, TYPE mask_val) { return src_val & mask_val; });
-        std::transform(dst, dst + length, mask_to_apply.cbegin(), old_and_not_mask.begin(),
-                       [](TYPE curr_val, TYPE mask_val) { return curr_val & (~mask_val); });
-        std::transform(
-            new_and_mask.cbegin(), new_and_mask.cend(), old_and_not_mask.cbegin(), dst,
-            [](TYPE new_and_mask_val, TYPE old_and_not_mask_val) { return new_and_mask_val | old_and_not_mask_val; });
+        const TYPE mask = m_mask;
+        /* single pass with no temporaries, which the compiler can vectorise */
+        for (uint64_t i = 0; i < length; i++) {
+            dst[i] = (src[i] & mask) | (dst[i] & ~mask);
+        }
     }
 
     TYPE& operator[](int idx)
@@ -312,8 +367,8 @@ public:
             }
         }
         SCP_TRACE(())("Access value (DMI) using operator [] at idx {}", idx);
-        if (p_mask.get_value() != gs_full_mask<TYPE>()) {
-            SCP_FATAL(()) << "operator[](): Register Mask: 0x" << std::hex << p_mask.get_value()
+        if (m_mask != gs_full_mask<TYPE>()) {
+            SCP_FATAL(()) << "operator[](): Register Mask: 0x" << std::hex << m_mask
                           << " has readonly bits, please use set(TYPE* src, uint64_t idx, uint64_t length) and "
                              "get(TYPE* dst, uint64_t idx, uint64_t length) instead";
         }
@@ -336,6 +391,8 @@ public:
     {
         initiator_socket.register_invalidate_direct_mem_ptr(this,
                                                             &gs::proxy_data_array<TYPE>::invalidate_direct_mem_ptr);
+        m_mask = p_mask.get_value();
+        p_mask.register_post_write_callback([this](auto ev) { m_mask = ev.new_value; });
     }
 };
 
@@ -369,6 +426,19 @@ public:
     }
 };
 
+/**
+ * @brief Value access common to all the register implementations (gs_register, gs_bank_register), used by fields
+ * and bitfields. Writes honour the register mask.
+ */
+template <class TYPE>
+class gs_register_if
+{
+public:
+    virtual TYPE get_value() = 0;
+    virtual void set_value(TYPE value) = 0;
+    virtual ~gs_register_if() = default;
+};
+
 /* forward declaration */
 template <class TYPE = uint32_t>
 class gs_bitfield;
@@ -382,7 +452,7 @@ class gs_register_element;
  *
  */
 template <class TYPE = uint32_t>
-class gs_register : public port_fnct, public proxy_data<TYPE>
+class gs_register : public port_fnct, public proxy_data<TYPE>, public gs_register_if<TYPE>
 {
     SCP_LOGGER((), "register");
 
@@ -422,9 +492,14 @@ public:
             }
             return (unsigned int)0;
         });
+        proxy_data<TYPE>::p_mask.register_post_write_callback([this](auto ev) {
+            if (ev.new_value != gs_full_mask<TYPE>()) invalidate_dmi();
+        });
     }
     void operator=(TYPE value) { proxy_data<TYPE>::set(value); }
     operator TYPE() { return proxy_data<TYPE>::get(); }
+    TYPE get_value() override { return proxy_data<TYPE>::get(); }
+    void set_value(TYPE value) override { proxy_data<TYPE>::set(value); }
 
     void operator=(gs_register<TYPE>& other) { proxy_data<TYPE>::set(proxy_data<TYPE>::get()); }
     void operator+=(TYPE other) { proxy_data<TYPE>::set(proxy_data<TYPE>::get() + other); }
@@ -458,10 +533,11 @@ public:
         SCP_TRACE(()) << "Set Mask to 0x" << std::hex << mask;
         proxy_data<TYPE>::p_mask = mask;
     }
-    TYPE get_mask() const { return proxy_data<TYPE>::p_mask.get_value(); }
+    TYPE get_mask() const { return proxy_data<TYPE>::m_mask; }
+    bool is_write_masked() override { return proxy_data<TYPE>::m_mask != gs_full_mask<TYPE>(); }
     void capture_txn_pre(tlm::tlm_generic_payload& txn) override
     {
-        if ((proxy_data<TYPE>::p_mask.get_value() == gs_full_mask<TYPE>()) ||
+        if ((proxy_data<TYPE>::m_mask == gs_full_mask<TYPE>()) ||
             (txn.get_command() != tlm::tlm_command::TLM_WRITE_COMMAND)) {
             return;
         }
@@ -481,7 +557,7 @@ public:
     }
     void handle_mask_post(tlm::tlm_generic_payload& txn) override
     {
-        if ((proxy_data<TYPE>::p_mask.get_value() == gs_full_mask<TYPE>()) ||
+        if ((proxy_data<TYPE>::m_mask == gs_full_mask<TYPE>()) ||
             (txn.get_command() != tlm::tlm_command::TLM_WRITE_COMMAND)) {
             return;
         }
@@ -512,20 +588,20 @@ template <class TYPE>
 class gs_bitfield
 {
     uint32_t start, length;
-    gs_register<TYPE>& m_reg;
+    gs_register_if<TYPE>& m_reg;
 
 public:
-    gs_bitfield(gs_register<TYPE>& r, uint32_t s, uint32_t l): m_reg(r), start(s), length(l) {}
+    gs_bitfield(gs_register_if<TYPE>& r, uint32_t s, uint32_t l): m_reg(r), start(s), length(l) {}
 
-    gs_bitfield(gs_register<TYPE>& r, gs_bitfield& f): m_reg(r), start(f.start), length(f.length) {}
+    gs_bitfield(gs_register_if<TYPE>& r, gs_bitfield& f): m_reg(r), start(f.start), length(f.length) {}
 
     void operator=(TYPE value)
     {
         sc_assert(value < (1ull << length));
-        m_reg &= ~(((1ull << length) - 1) << start);
-        m_reg |= value << start;
+        TYPE mask = ((1ull << length) - 1) << start;
+        m_reg.set_value((m_reg.get_value() & ~mask) | (value << start));
     }
-    operator TYPE() { return (m_reg >> start) & ((1ull << length) - 1); }
+    operator TYPE() { return (m_reg.get_value() >> start) & ((1ull << length) - 1); }
 };
 
 /**
@@ -537,13 +613,14 @@ template <class TYPE>
 class gs_field
 {
     SCP_LOGGER();
-    gs_register<TYPE>& m_reg;
+    gs_register_if<TYPE>& m_reg;
     uint32_t m_bit_start;
     uint32_t m_bit_length;
     gs_bitfield<TYPE> m_bitfield;
 
 public:
-    gs_field(gs_register<TYPE>& reg, std::string name, uint32_t bit_start = 0, uint32_t bit_length = sizeof(TYPE) * 8)
+    gs_field(gs_register_if<TYPE>& reg, std::string name, uint32_t bit_start = 0,
+             uint32_t bit_length = sizeof(TYPE) * 8)
         : m_reg(reg), m_bit_start(bit_start), m_bit_length(bit_length), m_bitfield(reg, m_bit_start, m_bit_length)
     {
         SCP_TRACE(())("gs_field constructor");
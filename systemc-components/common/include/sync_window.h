@@ -4,6 +4,9 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#ifndef SYNC_WINDOW_H
+#define SYNC_WINDOW_H
+
 #include <systemc>
 #include <tlm>
 #include <cci_configuration>
@@ -201,4 +204,6 @@ public:
         }
 };
 
-} // namespace sc_core
\ No newline at end of file
+} // namespace sc_core
+
+#endif // SYNC_WINDOW_H
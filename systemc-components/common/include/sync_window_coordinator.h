@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SYNC_WINDOW_COORDINATOR_H
+#define SYNC_WINDOW_COORDINATOR_H
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include <sync_window.h>
+
+namespace sc_core {
+
+/**
+ * @brief Per participant statistics of a N party synchronisation.
+ * lag is how far the participant's window starts behind the most advanced
+ * participant, limiting counts how many times its window became the one
+ * bounding the horizon of the others.
+ */
+struct sc_sync_window_lag_stats {
+    uint64_t updates = 0;
+    uint64_t limiting = 0;
+    sc_core::sc_time max_lag = sc_core::SC_ZERO_TIME;
+    sc_core::sc_time total_lag = sc_core::SC_ZERO_TIME;
+
+    sc_core::sc_time avg_lag() const { return updates ? total_lag / double(updates) : sc_core::SC_ZERO_TIME; }
+};
+
+/**
+ * @brief Computes the window each of N participants may run in, given the
+ * windows published by all of them: the minimum over all the other
+ * participants' windows. Not thread safe, callers serialise access.
+ * horizon() is O(1), as the two smallest bounds are kept; set() is O(n), as
+ * they are recomputed over all the windows.
+ *
+ * @tparam window  sc_sync_window<>::window
+ */
+template <class window>
+class sc_sync_window_horizon
+{
+    std::vector<window> m_windows;
+    std::vector<bool> m_published;
+    std::vector<sc_sync_window_lag_stats> m_stats;
+    size_t m_missing;
+
+    /* The two smallest values of 'from' and 'to', and who holds the smallest */
+    sc_core::sc_time m_from[2];
+    sc_core::sc_time m_to[2];
+    size_t m_from_min;
+    size_t m_to_min;
+
+    void update_minimums()
+    {
+        m_from[0] = m_from[1] = m_to[0] = m_to[1] = sc_core::sc_max_time();
+        m_from_min = m_to_min = 0;
+        for (size_t i = 0; i < m_windows.size(); i++) {
+            const window& w = m_windows[i];
+            if (w.from < m_from[0]) {
+                m_from[1] = m_from[0];
+                m_from[0] = w.from;
+                m_from_min = i;
+            } else if (w.from < m_from[1]) {
+                m_from[1] = w.from;
+            }
+            if (w.to < m_to[0]) {
+                m_to[1] = m_to[0];
+                m_to[0] = w.to;
+                m_to_min = i;
+            } else if (w.to < m_to[1]) {
+                m_to[1] = w.to;
+            }
+        }
+    }
+
+public:
+    explicit sc_sync_window_horizon(size_t n = 0) { resize(n); }
+
+    void resize(size_t n)
+    {
+        m_windows.resize(n, { sc_core::SC_ZERO_TIME, sc_core::SC_ZERO_TIME });
+        m_published.resize(n, false);
+        m_stats.resize(n);
+        m_missing = std::count(m_published.begin(), m_published.end(), false);
+        update_minimums();
+    }
+
+    size_t size() const { return m_windows.size(); }
+
+    /* Every participant published at least once, the horizons are meaningful */
+    bool complete() const { return m_missing == 0; }
+
+    /* Record the window published by participant i, returns false if unchanged */
+    bool set(size_t i, const window& w)
+    {
+        if (m_published[i] && m_windows[i] == w) return false;
+        bool was_complete = complete();
+        size_t prev_to_min = m_to_min;
+        if (!m_published[i]) {
+            m_published[i] = true;
+            m_missing--;
+        }
+        m_windows[i] = w;
+        update_minimums();
+
+        sc_sync_window_lag_stats& s = m_stats[i];
+        s.updates++;
+        if (complete() && (!was_complete || m_to_min != prev_to_min)) m_stats[m_to_min].limiting++;
+        if (w.to == sc_core::sc_max_time()) return true;
+
+        sc_core::sc_time lead = sc_core::SC_ZERO_TIME;
+        for (size_t k = 0; k < m_windows.size(); k++) {
+            /* detached participants publish an open window, they lead nobody */
+            if (m_windows[k].to != sc_core::sc_max_time()) lead = std::max(lead, m_windows[k].from);
+        }
+        sc_core::sc_time lag = (lead > w.from) ? lead - w.from : sc_core::SC_ZERO_TIME;
+        s.total_lag += lag;
+        s.max_lag = std::max(s.max_lag, lag);
+        return true;
+    }
+
+    /* Window participant j may run in: the minimum of all the others */
+    window horizon(size_t j) const
+    {
+        /* alone, nobody constrains us */
+        if (m_windows.size() < 2) return { sc_core::SC_ZERO_TIME, sc_core::sc_max_time() };
+        return { (j == m_from_min) ? m_from[1] : m_from[0], (j == m_to_min) ? m_to[1] : m_to[0] };
+    }
+
+    const sc_sync_window_lag_stats& stats(size_t i) const { return m_stats[i]; }
+};
+
+/**
+ * @brief Binds N sc_sync_window of the same process (e.g. one per SystemC
+ * kernel thread) together. Each window is allowed to run up to the minimum
+ * of all the other windows, instead of being chained pairwise.
+ */
+template <class sc_sync_policy = sc_sync_policy_in_sync>
+class sc_sync_window_coordinator
+{
+    using window = typename sc_sync_window<sc_sync_policy>::window;
+
+    std::mutex m_mutex;
+    std::vector<sc_sync_window<sc_sync_policy>*> m_participants;
+    std::vector<window> m_sent;
+    sc_sync_window_horizon<window> m_horizon;
+
+    /* Called from the thread of participant i */
+    void publish(size_t i, const window& w)
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        if (!m_horizon.set(i, w) || !m_horizon.complete()) return;
+
+        for (size_t j = 0; j < m_participants.size(); j++) {
+            window h = m_horizon.horizon(j);
+            if (!(h == m_sent[j])) {
+                m_sent[j] = h;
+                m_participants[j]->async_set_window(h);
+            }
+        }
+    }
+
+public:
+    /* Add a participant, before the simulation starts. Returns its index */
+    size_t add(sc_sync_window<sc_sync_policy>& w)
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        size_t i = m_participants.size();
+        m_participants.push_back(&w);
+        m_sent.push_back({ sc_core::SC_ZERO_TIME, sc_core::SC_ZERO_TIME });
+        m_horizon.resize(m_participants.size());
+        w.register_sync_cb([this, i](const window& win) { publish(i, win); });
+        return i;
+    }
+
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        return m_participants.size();
+    }
+
+    sc_sync_window_lag_stats get_stats(size_t i)
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        return m_horizon.stats(i);
+    }
+};
+
+} // namespace sc_core
+
+#endif // SYNC_WINDOW_COORDINATOR_H
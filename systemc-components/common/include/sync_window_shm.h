@@ -0,0 +1,531 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SYNC_WINDOW_SHM_H
+#define SYNC_WINDOW_SHM_H
+
+#ifndef _WIN32
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <ctime>
+#endif
+
+#include <sync_window.h>
+#include <sync_window_coordinator.h>
+
+namespace sc_core {
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shared windows need lock free 64 bit atomics");
+
+/**
+ * @brief A window published in shared memory by one participant, guarded by
+ * a seqlock. Each slot has its own cache line.
+ */
+struct alignas(64) sc_sync_window_shm_slot {
+    std::atomic<uint32_t> seq;
+    std::atomic<uint32_t> waiting;
+    std::atomic<uint64_t> from;
+    std::atomic<uint64_t> to;
+
+    /* Single writer */
+    void write(const sc_core::sc_time& f, const sc_core::sc_time& t)
+    {
+        uint32_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        from.store(f.value(), std::memory_order_relaxed);
+        to.store(t.value(), std::memory_order_relaxed);
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    /* Returns false if nothing was ever written */
+    bool read(uint32_t& s, sc_core::sc_time& f, sc_core::sc_time& t) const
+    {
+        uint32_t again;
+        uint64_t vf, vt;
+        do {
+            s = seq.load(std::memory_order_acquire);
+            vf = from.load(std::memory_order_relaxed);
+            vt = to.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            again = seq.load(std::memory_order_relaxed);
+        } while ((s & 1) || s != again);
+        f = sc_core::sc_time::from_value(vf);
+        t = sc_core::sc_time::from_value(vt);
+        return s != 0;
+    }
+};
+
+namespace sync_window_shm {
+
+inline uint64_t resolution_fs()
+{
+    return static_cast<uint64_t>(sc_core::sc_get_time_resolution().to_seconds() * 1e15 + 0.5);
+}
+
+/* Sleep while *word == val, for at most 100ms */
+inline void futex_wait(std::atomic<uint32_t>* word, uint32_t val)
+{
+#ifdef __linux__
+    struct timespec ts = { 0, 100 * 1000 * 1000 };
+    /* Not FUTEX_WAIT_PRIVATE: the word is shared with other processes */
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, val, &ts, nullptr, 0);
+#else
+    std::this_thread::sleep_for(std::chrono::microseconds(20));
+#endif
+}
+
+inline void futex_wake(std::atomic<uint32_t>* word)
+{
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+/* Create and map a zero filled segment, replacing a stale one */
+inline void* create_segment(const std::string& name, size_t size)
+{
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd == -1 && errno == EEXIST) {
+        /* left over by a process which did not exit cleanly */
+        shm_unlink(name.c_str());
+        fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    }
+    if (fd == -1) {
+        SC_REPORT_ERROR("sc_sync_window_shm", ("can't create " + name + ": " + std::strerror(errno)).c_str());
+        return nullptr;
+    }
+    if (ftruncate(fd, size) == -1) {
+        close(fd);
+        SC_REPORT_ERROR("sc_sync_window_shm", ("can't size " + name + ": " + std::strerror(errno)).c_str());
+        return nullptr;
+    }
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        SC_REPORT_ERROR("sc_sync_window_shm", ("can't map " + name + ": " + std::strerror(errno)).c_str());
+        return nullptr;
+    }
+    return p;
+}
+
+/*
+ * Map a segment created by another process, waiting for it to appear and for
+ * its creator to store the magic number found at the start of all segments.
+ */
+inline void* join_segment(const std::string& name, size_t size, uint64_t magic, std::chrono::milliseconds timeout)
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+        int fd = shm_open(name.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+        if (fd != -1) {
+            struct stat st;
+            void* p = MAP_FAILED;
+            if (fstat(fd, &st) == 0 && st.st_size >= (off_t)size) {
+                p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+            close(fd);
+            if (p != MAP_FAILED) {
+                auto m = static_cast<std::atomic<uint64_t>*>(p);
+                while (m->load(std::memory_order_acquire) != magic && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::yield();
+                }
+                if (m->load(std::memory_order_acquire) == magic) {
+                    return p;
+                }
+                munmap(p, size);
+            }
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            SC_REPORT_ERROR("sc_sync_window_shm", ("can't join " + name).c_str());
+            return nullptr;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+} // namespace sync_window_shm
+
+/**
+ * @brief Layout of the shared memory segment binding two sc_sync_window in
+ * different processes. Each side owns a slot holding the window it last
+ * sent; the slot's sequence counter is also the futex word the other side
+ * sleeps on.
+ */
+struct sc_sync_window_shm_area {
+    static constexpr uint64_t MAGIC = 0x716278737977696eULL;
+
+    std::atomic<uint64_t> magic;
+    std::atomic<uint32_t> attached;
+    uint64_t resolution_fs;
+    sc_sync_window_shm_slot sides[2];
+};
+
+/**
+ * @brief Binds a sc_sync_window to a peer sc_sync_window in another process
+ * through a named shared memory segment, instead of a std::function in the
+ * same process.
+ *
+ * One process creates the segment, the other joins it by name. Windows sent by
+ * the local sc_sync_window are published in our side of the segment; a
+ * reader thread sleeps on the other side (futex on Linux, polling elsewhere)
+ * and forwards each new window with async_set_window(). Both processes must
+ * use the same SystemC time resolution.
+ */
+template <class sc_sync_policy = sc_sync_policy_in_sync>
+class sc_sync_window_shm_peer
+{
+    using window = typename sc_sync_window<sc_sync_policy>::window;
+    using area = sc_sync_window_shm_area;
+
+    sc_sync_window<sc_sync_policy>& m_window;
+    std::string m_name;
+    bool m_creator;
+    area* m_area = nullptr;
+    sc_sync_window_shm_slot* m_out = nullptr;
+    sc_sync_window_shm_slot* m_in = nullptr;
+
+    std::thread m_reader;
+    std::atomic<bool> m_running{ true };
+
+    std::atomic<uint64_t> m_sent{ 0 };
+    std::atomic<uint64_t> m_received{ 0 };
+
+    /* Called on the SystemC thread by our sc_sync_window */
+    void publish(const window& w)
+    {
+        m_out->write(w.from, w.to);
+        m_sent.fetch_add(1, std::memory_order_relaxed);
+
+        /* Pairs with the fence in reader(): either it sees the new seq, or we see it waiting */
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_out->waiting.load(std::memory_order_relaxed)) {
+            sync_window_shm::futex_wake(&m_out->seq);
+        }
+    }
+
+    void reader()
+    {
+        uint32_t last = 0;
+        while (m_running.load(std::memory_order_relaxed)) {
+            uint32_t seq = m_in->seq.load(std::memory_order_acquire);
+            if (seq != last && !(seq & 1)) {
+                window w;
+                m_in->read(seq, w.from, w.to);
+                last = seq;
+                m_received.fetch_add(1, std::memory_order_relaxed);
+                m_window.async_set_window(w);
+                continue;
+            }
+
+            m_in->waiting.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_in->seq.load(std::memory_order_relaxed) == seq && m_running.load(std::memory_order_relaxed)) {
+                sync_window_shm::futex_wait(&m_in->seq, seq);
+            }
+            m_in->waiting.store(0, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    /**
+     * @param window  local sc_sync_window to bind
+     * @param name    name of the shared memory segment (e.g. "/my_platform_sync")
+     * @param create  true in exactly one of the two processes
+     * @param timeout how long the joining side waits for the segment to appear
+     */
+    sc_sync_window_shm_peer(sc_sync_window<sc_sync_policy>& window, const std::string& name, bool create,
+                            std::chrono::milliseconds timeout = std::chrono::seconds(10))
+        : m_window(window), m_name(name), m_creator(create)
+    {
+        if (create) {
+            m_area = static_cast<area*>(sync_window_shm::create_segment(name, sizeof(area)));
+            if (!m_area) return;
+            /* The segment is zero filled, which is a valid state for all the atomics */
+            m_area->resolution_fs = sync_window_shm::resolution_fs();
+            m_area->attached.store(1, std::memory_order_relaxed);
+            m_area->magic.store(area::MAGIC, std::memory_order_release);
+        } else {
+            m_area = static_cast<area*>(sync_window_shm::join_segment(name, sizeof(area), area::MAGIC, timeout));
+            if (!m_area) return;
+            m_area->attached.fetch_add(1);
+            /* Both sides are mapped, the name is no longer needed */
+            shm_unlink(name.c_str());
+        }
+
+        if (m_area->resolution_fs != sync_window_shm::resolution_fs()) {
+            SC_REPORT_ERROR("sc_sync_window_shm", "both sides must use the same SystemC time resolution");
+        }
+
+        m_out = &m_area->sides[create ? 0 : 1];
+        m_in = &m_area->sides[create ? 1 : 0];
+        m_window.register_sync_cb([this](const window& w) { publish(w); });
+        m_reader = std::thread(&sc_sync_window_shm_peer::reader, this);
+    }
+
+    ~sc_sync_window_shm_peer()
+    {
+        m_running = false;
+        if (m_reader.joinable()) {
+            /* Shared futex, this also wakes our own reader */
+            sync_window_shm::futex_wake(&m_in->seq);
+            m_reader.join();
+        }
+        if (m_area) {
+            munmap(m_area, sizeof(area));
+        }
+        if (m_creator) {
+            shm_unlink(m_name.c_str());
+        }
+    }
+
+    sc_sync_window_shm_peer(const sc_sync_window_shm_peer&) = delete;
+    sc_sync_window_shm_peer& operator=(const sc_sync_window_shm_peer&) = delete;
+
+    bool is_attached() const { return m_area && m_area->attached.load() == 2; }
+
+    /* Last window published by the other side, open window until it sent one */
+    window remote_window() const
+    {
+        uint32_t seq;
+        window w;
+        if (!m_in || !m_in->read(seq, w.from, w.to)) {
+            return sc_sync_window<sc_sync_policy>::open_window;
+        }
+        return w;
+    }
+
+    uint64_t get_sent() const { return m_sent.load(); }
+    uint64_t get_received() const { return m_received.load(); }
+};
+
+/**
+ * @brief Layout of the shared memory segment binding up to MAX_PARTICIPANTS
+ * sc_sync_window in as many processes. Publishing bumps a global generation
+ * counter, which all the participants sleep on.
+ */
+struct sc_sync_window_shm_group_area {
+    static constexpr uint64_t MAGIC = 0x71627873796e6777ULL;
+    static constexpr size_t MAX_PARTICIPANTS = 64;
+
+    std::atomic<uint64_t> magic;
+    std::atomic<uint32_t> attached;
+    uint32_t participants;
+    uint64_t resolution_fs;
+    alignas(64) std::atomic<uint32_t> generation;
+    std::atomic<uint32_t> waiting;
+    sc_sync_window_shm_slot slots[MAX_PARTICIPANTS];
+};
+
+/**
+ * @brief Binds a sc_sync_window to N-1 other sc_sync_window, each in its own
+ * process, through a named shared memory segment. Each participant runs up
+ * to the minimum of the windows published by all the others, so the slowest
+ * participant bounds everybody directly rather than through a chain of pairs.
+ *
+ * Participant 0 creates the segment, participants 1..N-1 join it. The group
+ * does not constrain anybody until all the participants published a window.
+ * Each process keeps lag statistics for all the participants.
+ */
+template <class sc_sync_policy = sc_sync_policy_in_sync>
+class sc_sync_window_shm_group
+{
+    using window = typename sc_sync_window<sc_sync_policy>::window;
+    using area = sc_sync_window_shm_group_area;
+
+    sc_sync_window<sc_sync_policy>& m_window;
+    std::string m_name;
+    size_t m_index;
+    size_t m_count;
+    area* m_area = nullptr;
+
+    std::thread m_reader;
+    std::atomic<bool> m_running{ true };
+
+    /* Written by the reader thread, stats read from anywhere */
+    std::mutex m_mutex;
+    sc_sync_window_horizon<window> m_horizon;
+    window m_sent_window = { sc_core::SC_ZERO_TIME, sc_core::SC_ZERO_TIME };
+
+    std::atomic<uint64_t> m_sent{ 0 };
+    std::atomic<uint64_t> m_received{ 0 };
+
+    std::function<void()> m_receive_cb;
+
+    /* Called on the SystemC thread by our sc_sync_window */
+    void publish(const window& w)
+    {
+        m_area->slots[m_index].write(w.from, w.to);
+        m_sent.fetch_add(1, std::memory_order_relaxed);
+        notify();
+    }
+
+    void reader()
+    {
+        uint32_t last = 0;
+        while (m_running.load(std::memory_order_relaxed)) {
+            uint32_t gen = m_area->generation.load(std::memory_order_acquire);
+            if (gen != last) {
+                last = gen;
+                std::lock_guard<std::mutex> lg(m_mutex);
+                for (size_t k = 0; k < m_count; k++) {
+                    uint32_t seq;
+                    window w;
+                    if (m_area->slots[k].read(seq, w.from, w.to)) {
+                        m_horizon.set(k, w);
+                    }
+                }
+                /*
+                 * After reading the windows: whatever a participant sent
+                 * before publishing them is visible, and is handed over
+                 * before our window may move past it.
+                 */
+                if (m_receive_cb) m_receive_cb();
+                if (m_horizon.complete()) {
+                    window h = m_horizon.horizon(m_index);
+                    if (!(h == m_sent_window)) {
+                        m_sent_window = h;
+                        m_received.fetch_add(1, std::memory_order_relaxed);
+                        m_window.async_set_window(h);
+                    }
+                }
+                continue;
+            }
+
+            m_area->waiting.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_area->generation.load(std::memory_order_relaxed) == gen &&
+                m_running.load(std::memory_order_relaxed)) {
+                sync_window_shm::futex_wait(&m_area->generation, gen);
+            }
+            m_area->waiting.fetch_sub(1);
+        }
+    }
+
+public:
+    /**
+     * @param window  local sc_sync_window to bind
+     * @param name    name of the shared memory segment
+     * @param index   index of this participant, 0 creates the segment
+     * @param count   number of participants, at most MAX_PARTICIPANTS
+     * @param timeout how long joining participants wait for the segment to appear
+     */
+    sc_sync_window_shm_group(sc_sync_window<sc_sync_policy>& window, const std::string& name, size_t index,
+                             size_t count, std::chrono::milliseconds timeout = std::chrono::seconds(10))
+        : m_window(window), m_name(name), m_index(index), m_count(count), m_horizon(count)
+    {
+        if (count > area::MAX_PARTICIPANTS || index >= count) {
+            SC_REPORT_ERROR("sc_sync_window_shm", "invalid participant index or count");
+            return;
+        }
+
+        if (index == 0) {
+            m_area = static_cast<area*>(sync_window_shm::create_segment(name, sizeof(area)));
+            if (!m_area) return;
+            m_area->participants = count;
+            m_area->resolution_fs = sync_window_shm::resolution_fs();
+            m_area->attached.store(1, std::memory_order_relaxed);
+            m_area->magic.store(area::MAGIC, std::memory_order_release);
+        } else {
+            m_area = static_cast<area*>(sync_window_shm::join_segment(name, sizeof(area), area::MAGIC, timeout));
+            if (!m_area) return;
+            if (m_area->participants != count) {
+                SC_REPORT_ERROR("sc_sync_window_shm", "all participants must agree on their number");
+            }
+            /* Everybody is mapped, the name is no longer needed */
+            if (m_area->attached.fetch_add(1) + 1 == count) {
+                shm_unlink(name.c_str());
+            }
+        }
+
+        if (m_area->resolution_fs != sync_window_shm::resolution_fs()) {
+            SC_REPORT_ERROR("sc_sync_window_shm", "all participants must use the same SystemC time resolution");
+        }
+
+        m_window.register_sync_cb([this](const window& w) { publish(w); });
+        m_reader = std::thread(&sc_sync_window_shm_group::reader, this);
+    }
+
+    ~sc_sync_window_shm_group()
+    {
+        m_running = false;
+        if (m_reader.joinable()) {
+            sync_window_shm::futex_wake(&m_area->generation);
+            m_reader.join();
+        }
+        if (m_area) {
+            munmap(m_area, sizeof(area));
+        }
+        if (m_index == 0) {
+            shm_unlink(m_name.c_str());
+        }
+    }
+
+    sc_sync_window_shm_group(const sc_sync_window_shm_group&) = delete;
+    sc_sync_window_shm_group& operator=(const sc_sync_window_shm_group&) = delete;
+
+    bool is_complete() const { return m_area && m_area->attached.load() == m_count; }
+
+    /*
+     * Wake the reader threads of all the participants, e.g. after writing
+     * data for them next to the segment. Callable from any thread.
+     */
+    void notify()
+    {
+        m_area->generation.fetch_add(1, std::memory_order_release);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_area->waiting.load(std::memory_order_relaxed)) {
+            sync_window_shm::futex_wake(&m_area->generation);
+        }
+    }
+
+    /*
+     * Called by the reader thread each time a participant published or
+     * notified, before the resulting horizon is applied to our window.
+     */
+    void register_receive_cb(std::function<void()> fn)
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        m_receive_cb = fn;
+    }
+
+    /* Horizon currently applied to our window */
+    window get_horizon()
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        return m_horizon.complete() ? m_horizon.horizon(m_index) : sc_sync_window<sc_sync_policy>::open_window;
+    }
+
+    sc_sync_window_lag_stats get_stats(size_t i)
+    {
+        std::lock_guard<std::mutex> lg(m_mutex);
+        return m_horizon.stats(i);
+    }
+
+    uint64_t get_sent() const { return m_sent.load(); }
+    uint64_t get_received() const { return m_received.load(); }
+};
+
+} // namespace sc_core
+
+#endif // _WIN32
+#endif // SYNC_WINDOW_SHM_H
@@ -12,6 +12,8 @@
 
 #include <tlm>
 
+#include <tlm-extensions/extension_pool.h>
+
 /**
  * @class ExclusiveAccessTlmExtension
  *
@@ -31,8 +33,12 @@
  *
  * The store status is valid after a TLM_WRITE_COMMAND transaction and indicate
  * whether the exclusive store succeeded or not.
+ *
+ * Objects are recycled through the extension pool: use
+ * ExclusiveAccessTlmExtension::acquire() followed by reset() to get a fresh
+ * one, and free() to give it back.
  */
-class ExclusiveAccessTlmExtension : public tlm::tlm_extension<ExclusiveAccessTlmExtension>
+class ExclusiveAccessTlmExtension : public gs::pooled_tlm_extension<ExclusiveAccessTlmExtension>
 {
 public:
     enum ExclusiveStoreStatus { EXCLUSIVE_STORE_NA = 0, EXCLUSIVE_STORE_SUCCESS, EXCLUSIVE_STORE_FAILURE };
@@ -45,6 +51,8 @@ public:
     public:
         void add_hop(int id) { m_id.push_back(id); }
 
+        void clear() { m_id.clear(); }
+
         bool operator<(const InitiatorId& o) const
         {
             if (m_id.size() != o.m_id.size()) {
@@ -100,6 +108,12 @@ public:
         m_store_sta = other.m_store_sta;
     }
 
+    void reset()
+    {
+        m_id.clear();
+        m_store_sta = EXCLUSIVE_STORE_NA;
+    }
+
     void set_exclusive_store_success() { m_store_sta = EXCLUSIVE_STORE_SUCCESS; }
 
     void set_exclusive_store_failure() { m_store_sta = EXCLUSIVE_STORE_FAILURE; }
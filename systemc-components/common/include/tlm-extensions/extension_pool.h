@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _GREENSOCS_TLM_EXTENSIONS_EXTENSION_POOL_H
+#define _GREENSOCS_TLM_EXTENSIONS_EXTENSION_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <tlm>
+
+namespace gs {
+
+/**
+ * @class extension_pool
+ *
+ * @brief Per-thread free list of TLM extensions
+ *
+ * @details Each thread keeps a small cache of free objects. When a thread
+ * runs out, it takes a whole batch from a global depot; when its cache grows
+ * beyond two batches, it gives one back. Extensions are frequently acquired
+ * on one thread (e.g. the SystemC kernel) and released on another (e.g. a
+ * vCPU thread destroying its payload), the depot lets objects flow back
+ * without taking a lock on every access. Once the steady state is reached,
+ * no more allocation happens.
+ *
+ * The depot is never destroyed, as extensions may still be released by
+ * payloads destroyed late during program exit. When a thread exits, its cache
+ * is drained into the depot; extensions acquired or released afterwards by
+ * that thread (e.g. from the destructor of another thread_local object) go
+ * straight to the depot.
+ */
+template <class T, size_t BATCH = 32>
+class extension_pool
+{
+    struct depot {
+        std::mutex lock;
+        std::vector<T*> free;
+        std::atomic<uint64_t> allocations{ 0 };
+    };
+
+    static depot& get_depot()
+    {
+        static depot* d = new depot();
+        return *d;
+    }
+
+    struct cache {
+        std::vector<T*> free;
+
+        cache() { free.reserve(2 * BATCH); }
+
+        ~cache()
+        {
+            depot& d = get_depot();
+            std::lock_guard<std::mutex> l(d.lock);
+            d.free.insert(d.free.end(), free.begin(), free.end());
+            free.clear();
+            cache_destroyed() = true;
+        }
+    };
+
+    /* Trivially destructible, so it can still be read once the cache is gone */
+    static bool& cache_destroyed()
+    {
+        thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+    /* nullptr once the cache of the calling thread has been destroyed */
+    static cache* local()
+    {
+        if (cache_destroyed()) return nullptr;
+        thread_local cache c;
+        return &c;
+    }
+
+public:
+    /**
+     * @brief Get an extension from the pool. Its content is the one it had
+     * when it was released, the caller is responsible for re-initialising it.
+     */
+    static T* acquire()
+    {
+        cache* c = local();
+        if (!c) {
+            depot& d = get_depot();
+            {
+                std::lock_guard<std::mutex> l(d.lock);
+                if (!d.free.empty()) {
+                    T* ext = d.free.back();
+                    d.free.pop_back();
+                    return ext;
+                }
+            }
+            d.allocations++;
+            return new T();
+        }
+        if (c->free.empty()) {
+            depot& d = get_depot();
+            std::lock_guard<std::mutex> l(d.lock);
+            size_t n = std::min(d.free.size(), BATCH);
+            c->free.insert(c->free.end(), d.free.end() - n, d.free.end());
+            d.free.resize(d.free.size() - n);
+        }
+        if (c->free.empty()) {
+            get_depot().allocations++;
+            return new T();
+        }
+        T* ext = c->free.back();
+        c->free.pop_back();
+        return ext;
+    }
+
+    static void release(T* ext)
+    {
+        cache* c = local();
+        if (!c) {
+            depot& d = get_depot();
+            std::lock_guard<std::mutex> l(d.lock);
+            d.free.push_back(ext);
+            return;
+        }
+        c->free.push_back(ext);
+        if (c->free.size() >= 2 * BATCH) {
+            /* The depot capacity only grows until the steady state is reached */
+            depot& d = get_depot();
+            std::lock_guard<std::mutex> l(d.lock);
+            d.free.insert(d.free.end(), c->free.end() - BATCH, c->free.end());
+            c->free.resize(c->free.size() - BATCH);
+        }
+    }
+
+    /**
+     * @brief Number of extensions allocated by the pool since the start of
+     * the program (all threads).
+     */
+    static uint64_t allocations() { return get_depot().allocations.load(); }
+};
+
+/**
+ * @class pooled_tlm_extension
+ *
+ * @brief TLM extension base class whose objects are recycled through an
+ * extension_pool rather than deleted.
+ *
+ * @details Derive from this class instead of tlm::tlm_extension<T>, and use
+ * T::acquire() instead of new T. Whoever ends the life of the extension
+ * (the payload memory manager calling free(), or the owner) returns it to the
+ * pool through free().
+ */
+template <class T>
+class pooled_tlm_extension : public tlm::tlm_extension<T>
+{
+public:
+    static T* acquire() { return extension_pool<T>::acquire(); }
+
+    virtual void free() override { extension_pool<T>::release(static_cast<T*>(this)); }
+};
+
+} // namespace gs
+#endif
@@ -11,6 +11,8 @@
 #include <systemc>
 #include <tlm>
 
+#include <tlm-extensions/extension_pool.h>
+
 namespace gs {
 
 /**
@@ -19,10 +21,11 @@ namespace gs {
  * @brief Path recording TLM extension
  *
  * @details Embeds an  ID field in the txn, which is populated as the network
- * is traversed - see README.
+ * is traversed - see README. Objects are recycled through the extension pool,
+ * use PathIDExtension::acquire() to get one.
  */
 
-class PathIDExtension : public tlm::tlm_extension<PathIDExtension>, public std::vector<int>
+class PathIDExtension : public gs::pooled_tlm_extension<PathIDExtension>, public std::vector<int>
 {
 public:
     PathIDExtension() = default;
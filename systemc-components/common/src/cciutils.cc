@@ -21,25 +21,18 @@ sc_core::sc_object* gs::find_sc_obj(sc_core::sc_object* m, std::string name, boo
         return m;
     }
 
-    std::vector<sc_core::sc_object*> children;
-    if (m) {
-        children = m->get_child_objects();
-    } else {
-        children = sc_core::sc_get_top_level_objects();
+    /* The kernel keeps a table of all the objects by name, only check the object is below m */
+    sc_core::sc_object* obj = sc_core::sc_find_object(name.c_str());
+    for (sc_core::sc_object* p = obj; p && m; p = p->get_parent_object()) {
+        if (p == m) return obj;
     }
+    if (obj && !m) return obj;
 
-    auto ip_it = std::find_if(begin(children), end(children), [&name](sc_core::sc_object* o) {
-        return (name.compare(0, strlen(o->name()), o->name()) == 0) && find_sc_obj(o, name, true);
-    });
-    if (ip_it != end(children)) {
-        return find_sc_obj(*ip_it, name);
-    } else {
-        if (!test) {
-            if (m) {
-                SCP_ERR("cciutils.find_sc_obj") << "Unable to find " << name << " in sc_object " << m->name();
-            } else {
-                SCP_ERR("cciutils.find_sc_obj") << "Unable to find " << name;
-            }
+    if (!test) {
+        if (m) {
+            SCP_ERR("cciutils.find_sc_obj") << "Unable to find " << name << " in sc_object " << m->name();
+        } else {
+            SCP_ERR("cciutils.find_sc_obj") << "Unable to find " << name;
         }
     }
     return nullptr;
@@ -108,6 +101,65 @@ std::list<std::string> gs::sc_cci_list_items(sc_core::sc_module_name module_name
     return children;
 }
 
+void gs::cci_preset_index::build(cci_broker_handle broker, const std::string& prefix)
+{
+    clear();
+    if (prefix.empty()) {
+        m_values = broker.get_unconsumed_preset_values();
+    } else {
+        auto uncon = broker.get_unconsumed_preset_values([&prefix](const std::pair<std::string, cci_value>& iv) {
+            return iv.first.compare(0, prefix.size(), prefix) == 0;
+        });
+        for (auto p : uncon) m_values.push_back(p);
+    }
+
+    /* m_values is not modified from here on, nodes can point into it */
+    for (auto& v : m_values) {
+        node* n = &m_root;
+        size_t pos = 0;
+        for (;;) {
+            size_t dot = v.first.find('.', pos);
+            auto& child = n->children[v.first.substr(pos, dot - pos)];
+            if (!child) child.reset(new node);
+            n = child.get();
+            if (dot == std::string::npos) break;
+            pos = dot + 1;
+        }
+        n->value = &v;
+    }
+}
+
+void gs::cci_preset_index::clear()
+{
+    m_root.children.clear();
+    m_values.clear();
+}
+
+const gs::cci_preset_index::node* gs::cci_preset_index::find(const std::string& name) const
+{
+    const node* n = &m_root;
+    if (name.empty()) return n;
+    size_t pos = 0;
+    while (n) {
+        size_t dot = name.find('.', pos);
+        auto it = n->children.find(name.substr(pos, dot - pos));
+        n = (it == n->children.end()) ? nullptr : it->second.get();
+        if (dot == std::string::npos) break;
+        pos = dot + 1;
+    }
+    return n;
+}
+
+std::list<std::string> gs::cci_preset_index::children(const std::string& name) const
+{
+    std::list<std::string> ret;
+    const node* n = find(name);
+    if (n) {
+        for (auto& c : n->children) ret.push_back(c.first);
+    }
+    return ret;
+}
+
 std::string gs::get_parent_name(sc_core::sc_module_name n)
 {
     std::string name(n);
@@ -8,6 +8,8 @@
 
 #include <cerrno>
 #include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <sstream>
@@ -15,6 +17,7 @@
 #include <iostream>
 #include <map>
 #include <atomic>
+#include <vector>
 #include <filesystem>
 
 #include <dynlib_loader.h>
@@ -31,7 +34,11 @@
 #if defined(__APPLE__)
 #include <mach-o/dyld.h>
 #else
+#include <fcntl.h>
 #include <link.h>
+#include <sys/mman.h>
+#include <sys/file.h>
+#include <sys/sendfile.h>
 #endif
 #endif
 
@@ -149,6 +156,10 @@ class DefaultLibraryLoader : public qemu::LibraryLoaderIface
 
 private:
     std::string m_last_error;
+#if defined(__linux__)
+    std::map<std::string, unsigned> m_instances; // separate instances loaded, per library
+    std::vector<int> m_memfds;                    // kept open, see load_from_memfd()
+#endif
 
     bool is_library_loaded(const std::string& lib_path)
     {
@@ -325,6 +336,210 @@ private:
 #endif
     }
 
+#if defined(__linux__)
+    static bool copy_fd(int src, int dst, off_t size)
+    {
+        off_t off = 0;
+        while (off < size) {
+            ssize_t n = sendfile(dst, src, &off, size - off);
+            if (n <= 0) return false;
+        }
+        return true;
+    }
+
+    /*
+     * Copy the library into an anonymous memory file, nothing is written to disk.
+     * The fd stays open: the loader identifies libraries by name first, and a
+     * reused /proc/self/fd/N name would return the earlier instance.
+     */
+    void* load_from_memfd(const fs::path& original)
+    {
+        int src = open(original.c_str(), O_RDONLY | O_CLOEXEC);
+        if (src < 0) {
+            m_last_error = "Unable to open " + original.string() + ": " + strerror(errno);
+            return nullptr;
+        }
+        struct stat st;
+        int fd = -1;
+        if (fstat(src, &st) == 0) fd = memfd_create(original.filename().c_str(), MFD_CLOEXEC);
+        if (fd < 0 || !copy_fd(src, fd, st.st_size)) {
+            m_last_error = "Unable to copy " + original.string() + " to memory: " + strerror(errno);
+            if (fd >= 0) close(fd);
+            close(src);
+            return nullptr;
+        }
+        close(src);
+
+        std::string path = "/proc/self/fd/" + std::to_string(fd);
+        void* handle = dlopen(path.c_str(), RTLD_LOCAL | RTLD_NOW);
+        if (handle == nullptr) {
+            m_last_error = dlerror();
+            close(fd);
+            return nullptr;
+        }
+        m_memfds.push_back(fd);
+        return handle;
+    }
+
+    fs::path cache_dir()
+    {
+        const char* dir = std::getenv("GS_LIB_CACHE_DIR");
+        if (dir && *dir) return fs::path(dir);
+        dir = std::getenv("XDG_CACHE_HOME");
+        if (dir && *dir) return fs::path(dir) / "qbox" / "libs";
+        dir = std::getenv("HOME");
+        if (dir && *dir) return fs::path(dir) / ".cache" / "qbox" / "libs";
+        return "";
+    }
+
+    static uint64_t fnv1a(uint64_t h, const void* data, size_t len)
+    {
+        const uint8_t* c = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < len; i++) {
+            h ^= c[i];
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    static std::string to_hex(uint64_t h)
+    {
+        char buf[17];
+        std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(h));
+        return buf;
+    }
+
+    /* Identifies the library, whatever its build */
+    static std::string path_key(const fs::path& path)
+    {
+        std::string p = path.string();
+        return to_hex(fnv1a(1469598103934665603ull, p.data(), p.size()));
+    }
+
+    /*
+     * Identifies one build of the library. Hashing the content of a library of
+     * a few hundred MB would cost as much as copying it, so the key is a hash of
+     * its inode, size and modification time.
+     */
+    static std::string build_key(const struct stat& st)
+    {
+        uint64_t h = 1469598103934665603ull;
+        h = fnv1a(h, &st.st_ino, sizeof(st.st_ino));
+        h = fnv1a(h, &st.st_size, sizeof(st.st_size));
+        h = fnv1a(h, &st.st_mtim, sizeof(st.st_mtim));
+        return to_hex(h);
+    }
+
+    /*
+     * Copy number 'index' of the library, kept in the cache directory and reused
+     * by the following runs. The copies of a library are in
+     * <name>-<path key>-<build key>, the copies of the other builds of the same
+     * library (same path key) are removed when a new build is first seen.
+     * Runs sharing the cache serialise on <name>-<path key>.lock, so that
+     * a run never removes or overwrites the copies another one is loading.
+     */
+    void* load_from_cache(const fs::path& original, unsigned index)
+    {
+        struct stat st;
+        fs::path base = cache_dir();
+        if (base.empty() || stat(original.c_str(), &st) != 0) return nullptr;
+
+        std::string stem = original.filename().string() + "-" + path_key(original);
+        fs::path dir = base / (stem + "-" + build_key(st));
+        fs::path copy = dir / (std::to_string(index) + "." + get_lib_ext());
+        std::error_code ec;
+
+        fs::create_directories(base, ec);
+        if (ec) return nullptr;
+        fs::path lock_path = base / (stem + ".lock");
+        int lock_fd = open(lock_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (lock_fd < 0) return nullptr;
+        if (flock(lock_fd, LOCK_EX) != 0) {
+            close(lock_fd);
+            return nullptr;
+        }
+
+        void* handle = nullptr;
+        if (!fs::exists(dir, ec)) {
+            for (auto& entry : fs::directory_iterator(base, ec)) {
+                if (entry.path().filename().string().rfind(stem + "-", 0) == 0) {
+                    std::error_code rm_ec;
+                    fs::remove_all(entry.path(), rm_ec);
+                }
+            }
+            ec.clear();
+        }
+        if (!fs::exists(copy, ec)) {
+            fs::create_directories(dir, ec);
+            /* Copy then rename, so that a run not using the lock never sees a partial copy */
+            fs::path tmp = dir / (std::to_string(index) + ".tmp." + std::to_string(getpid()));
+            if (!ec) fs::copy_file(original, tmp, fs::copy_options::overwrite_existing, ec);
+            if (!ec) fs::rename(tmp, copy, ec);
+            if (ec) {
+                std::error_code rm_ec;
+                fs::remove(tmp, rm_ec);
+            }
+        }
+        if (!ec) {
+            handle = dlopen(copy.c_str(), RTLD_LOCAL | RTLD_NOW);
+            if (handle == nullptr) m_last_error = dlerror();
+        }
+
+        flock(lock_fd, LOCK_UN);
+        close(lock_fd);
+        return handle;
+    }
+
+    /*
+     * Separate instances of a library already loaded, the way is chosen with the
+     * GS_LIB_INSTANCE_MODE environment variable:
+     *  - memfd (default): a copy in anonymous memory, nothing is written to disk.
+     *  - cache: copies kept in $GS_LIB_CACHE_DIR (or the user's cache
+     *    directory) and reused across runs. Falls back to memfd. This is the
+     *    default when GS_LIB_CACHE_DIR is set.
+     *  - dlmopen: the same file in a new link-map namespace, nothing is copied.
+     *    glibc only provides a few namespaces, and the library does not see the
+     *    symbols of the program. Falls back to memfd.
+     *  - copy: a copy in /tmp.
+     */
+    qemu::LibraryLoaderIface::LibraryIfacePtr load_separate_instance(const std::string& lib_name)
+    {
+        const char* env = std::getenv("GS_LIB_INSTANCE_MODE");
+        const char* cache_env = std::getenv("GS_LIB_CACHE_DIR");
+        std::string mode = (env && *env) ? env : ((cache_env && *cache_env) ? "cache" : "memfd");
+        if (mode == "copy") return duplicate_and_load_library(lib_name);
+
+        fs::path original_path(get_loaded_library_path(lib_name));
+        if (original_path.empty()) {
+            return nullptr;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        unsigned index = ++m_instances[original_path.string()];
+        void* handle = nullptr;
+        if (mode == "dlmopen") {
+            handle = dlmopen(LM_ID_NEWLM, original_path.c_str(), RTLD_LOCAL | RTLD_NOW);
+            if (handle == nullptr) {
+                SCP_WARN(())("dlmopen of {} failed ({}), copying it instead", original_path.string(), dlerror());
+            }
+        } else if (mode == "cache") {
+            handle = load_from_cache(original_path, index);
+            if (handle == nullptr) {
+                SCP_WARN(())("Unable to use the library cache in {}, copying {} to memory instead",
+                             cache_dir().string(), original_path.string());
+            }
+        } else if (mode != "memfd") {
+            SCP_WARN(())("Unknown GS_LIB_INSTANCE_MODE '{}', using memfd", mode);
+        }
+        if (handle == nullptr) handle = load_from_memfd(original_path);
+        if (handle == nullptr) return nullptr;
+
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        SCP_INFO(())("Instance {} of {} loaded in {:.1f}ms ({})", index, original_path.string(), elapsed * 1e3, mode);
+        return std::make_shared<Library>(handle);
+    }
+#endif
+
 public:
     qemu::LibraryLoaderIface::LibraryIfacePtr load_library(const std::string& lib_name, bool load_as_separate_instance)
     {
@@ -332,7 +547,11 @@ public:
         // the library must be copied into a new location and loaded from there.
         if (load_as_separate_instance && is_library_loaded(lib_name)) {
             std::cout << "Loading separate instance of library: " << lib_name << std::endl;
+#if defined(__linux__)
+            return load_separate_instance(lib_name);
+#else
             return duplicate_and_load_library(lib_name);
+#endif
         }
 
         // Load the library
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SC_INCLUDE_DYNAMIC_PROCESSES
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+#endif
+#include <systemc>
+#include <pre_suspending_sc_support.h>
+#include <qkmulti-lockfree.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+namespace gs {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+
+tlm_quantumkeeper_multithread_lockfree::tlm_quantumkeeper_multithread_lockfree()
+{
+    m_sc_ticks = sc_core::sc_time_stamp().value();
+    publish_local();
+}
+
+void tlm_quantumkeeper_multithread_lockfree::kick_systemc()
+{
+    if (m_sc_suspended.exchange(false)) {
+        m_kicks++;
+        m_tick.notify(sc_core::SC_ZERO_TIME);
+    }
+}
+
+/*
+ * The release orders the m_sc_ticks store (and the suspend state) before the
+ * new epoch: a thread which sees the new epoch with an acquire load then reads
+ * at least that time in time_to_sync(). The fence orders the increment before
+ * the load of m_waiters, against the m_waiters increment done by a thread about
+ * to park: either we see it and wake it, or its futex wait sees the new epoch.
+ */
+void tlm_quantumkeeper_multithread_lockfree::publish_epoch()
+{
+    m_epoch.fetch_add(1, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_waiters.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_epoch), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+#else
+    std::lock_guard<std::mutex> lock(m_park_mutex);
+    m_park_cond.notify_all();
+#endif
+}
+
+void tlm_quantumkeeper_multithread_lockfree::park(uint32_t epoch, std::chrono::milliseconds timeout)
+{
+    m_parks++;
+#ifdef __linux__
+    struct timespec ts;
+    ts.tv_sec = timeout.count() / 1000;
+    ts.tv_nsec = (timeout.count() % 1000) * 1000000;
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_epoch), FUTEX_WAIT_PRIVATE, epoch, &ts, nullptr, 0);
+#else
+    std::unique_lock<std::mutex> lock(m_park_mutex);
+    m_park_cond.wait_for(lock, timeout, [&]() { return m_epoch.load(std::memory_order_acquire) != epoch; });
+#endif
+}
+
+void tlm_quantumkeeper_multithread_lockfree::wake_external() { publish_epoch(); }
+
+/* SystemC side: publish our time, then compare with the external time */
+void tlm_quantumkeeper_multithread_lockfree::timehandler()
+{
+    uint64_t now = sc_core::sc_time_stamp().value();
+    m_sc_ticks.store(now, std::memory_order_release);
+
+    if (status != RUNNING) {
+        m_sc_suspended = false;
+        m_systemc_waiting = false;
+        SCP_TRACE(())("Unsuspending (stopped)");
+        sc_core::sc_unsuspend_all();
+        m_tick.async_detach_suspending();
+        publish_epoch();
+        return;
+    }
+
+    /*
+     * Announce we are about to suspend before looking at the external time:
+     * either we see the time it published, or it sees the flag and kicks us.
+     * The fence keeps the load from being ordered before the store, which a
+     * seq_cst store followed by an acquire load alone allows; the external
+     * side pairs with it through the seq_cst exchange in kick_systemc().
+     */
+    m_sc_suspended.store(true, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t local = m_local_ticks.load(std::memory_order_acquire);
+
+    if (local > now) {
+        m_sc_suspended = false;
+        m_systemc_waiting = false;
+        SCP_TRACE(())("Unsuspending");
+        sc_core::sc_unsuspend_all();
+        sc_core::sc_time quantum = tlm_utils::tlm_quantumkeeper::get_global_quantum();
+        m_tick.notify(std::min(sc_core::sc_time::from_value(local - now), quantum));
+    } else {
+        m_systemc_waiting = true;
+        SCP_TRACE(())("Suspending");
+        sc_core::sc_suspend_all();
+    }
+
+    publish_epoch();
+}
+
+sc_core::sc_time tlm_quantumkeeper_multithread_lockfree::time_to_sync()
+{
+    sc_core::sc_time quantum = tlm_utils::tlm_quantumkeeper::get_global_quantum();
+    sc_core::sc_time sc_t = is_sysc_thread() ? sc_core::sc_time_stamp()
+                                             : sc_core::sc_time::from_value(m_sc_ticks.load(std::memory_order_acquire));
+    sc_core::sc_time q = sc_t + (quantum * 2);
+    if (q >= m_local_time) {
+        return q - m_local_time;
+    } else {
+        return sc_core::SC_ZERO_TIME;
+    }
+}
+
+void tlm_quantumkeeper_multithread_lockfree::inc(const sc_core::sc_time& t)
+{
+    m_local_time += t;
+    publish_local();
+}
+
+void tlm_quantumkeeper_multithread_lockfree::set(const sc_core::sc_time& t)
+{
+    tlm_quantumkeeper_multithread::set(t);
+    publish_local();
+}
+
+void tlm_quantumkeeper_multithread_lockfree::reset()
+{
+    tlm_quantumkeeper_multithread::reset();
+    publish_local();
+}
+
+sc_core::sc_time tlm_quantumkeeper_multithread_lockfree::get_current_time() const
+{
+    if (is_sysc_thread()) {
+        return sc_core::sc_time::from_value(m_local_ticks.load(std::memory_order_acquire));
+    }
+    return m_local_time;
+}
+
+void tlm_quantumkeeper_multithread_lockfree::sync()
+{
+    if (is_sysc_thread()) {
+        tlm_quantumkeeper_multithread::sync();
+        return;
+    }
+
+    m_syncs++;
+    publish_local();
+    /* Wake up the SystemC thread if it's waiting for us to keep up */
+    kick_systemc();
+
+    m_extern_waiting = true;
+    while (status == RUNNING) {
+        uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+        if (time_to_sync() != sc_core::SC_ZERO_TIME) {
+            break;
+        }
+        m_waiters++;
+        /* SystemC may have suspended since we published */
+        kick_systemc();
+        auto start = std::chrono::steady_clock::now();
+        park(epoch, std::chrono::milliseconds(1000));
+        m_waiters--;
+        if (m_epoch.load(std::memory_order_acquire) == epoch &&
+            std::chrono::steady_clock::now() - start >= std::chrono::seconds(1)) {
+            SCP_WARN(())("wait_for timeout");
+            m_tick.notify(sc_core::SC_ZERO_TIME);
+        }
+    }
+    m_extern_waiting = false;
+}
+} // namespace gs
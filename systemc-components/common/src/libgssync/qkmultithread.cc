@@ -119,6 +119,7 @@ void tlm_quantumkeeper_multithread::stop()
             status = STOPPED;
             m_tick.notify(sc_core::SC_ZERO_TIME);
             cond.notify_all();
+            wake_external();
             /*
              * Don't call m_tick.async_detach_suspending() here. When called
              * from the QEMU thread, it's deferred and can race with a
@@ -134,6 +135,12 @@ void tlm_quantumkeeper_multithread::stop()
     }
 }
 
+void tlm_quantumkeeper_multithread::notify_external()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    cond.notify_all();
+}
+
 /* this may be overloaded to provide a different window */
 /* return the time remaining till the next sync point*/
 sc_core::sc_time tlm_quantumkeeper_multithread::time_to_sync()
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <systemc>
+
+#include <cstring>
+
+#include <scp/report.h>
+
+#include "backends/loopback.h"
+
+using namespace sc_core;
+
+NetworkBackendLoopback::NetworkBackendLoopback(sc_core::sc_module_name name, size_t max_frames)
+    : sc_module(name), m_pool(9018), m_max_frames(max_frames), m_dropped(0)
+{
+    SCP_TRACE(SCMOD) << "Constructor";
+
+    SC_METHOD(rcv);
+    sensitive << m_event;
+    dont_initialize();
+}
+
+NetworkBackendLoopback::~NetworkBackendLoopback()
+{
+    for (Payload* frame : m_queue) {
+        m_pool.put(frame);
+    }
+}
+
+void NetworkBackendLoopback::send(Payload& frame)
+{
+    if (!m_receive || m_queue.size() >= m_max_frames || frame.size() > m_pool.capacity()) {
+        SCP_TRACE(SCMOD) << "dropping frame of size " << frame.size();
+        m_dropped++;
+        return;
+    }
+    SCP_TRACE(SCMOD) << "frame of size " << frame.size() << " looped back";
+
+    Payload* copy = m_pool.get();
+    copy->resize(frame.size());
+    std::memcpy(copy->data(), frame.data(), frame.size());
+    m_queue.push_back(copy);
+    m_event.notify(SC_ZERO_TIME);
+}
+
+void NetworkBackendLoopback::rcv()
+{
+    while (!m_queue.empty()) {
+        if (!m_can_receive(m_opaque)) {
+            /* notify myself later, hopefully the MAC is ready by then */
+            m_event.notify(sc_core::sc_time(1, sc_core::SC_MS));
+            return;
+        }
+        Payload* frame = m_queue.front();
+        m_queue.pop_front();
+        m_receive(m_opaque, *frame);
+        m_pool.put(frame);
+    }
+}
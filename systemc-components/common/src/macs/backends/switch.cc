@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <systemc>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <scp/report.h>
+
+#include "backends/switch.h"
+
+using namespace sc_core;
+
+static uint64_t mac_address(const uint8_t* data)
+{
+    uint64_t addr = 0;
+    for (int i = 0; i < 6; i++) {
+        addr = (addr << 8) | data[i];
+    }
+    return addr;
+}
+
+NetworkSwitch::NetworkSwitch(const sc_core::sc_module_name& name)
+    : sc_module(name)
+    , p_pcap("pcap", "", "File the frames going through the switch are captured to, none if empty")
+    , p_delivery_period("delivery_period", sc_core::SC_ZERO_TIME,
+                        "Frames are delivered to the ports at multiples of this period, in the next delta cycle if 0")
+    , p_queue_frames("queue_frames", 256, "Frames queued per port, the next ones are dropped")
+    , p_shm_link("shm_link", "", "Shared memory connecting this switch to the one of another simulator, none if empty")
+    , m_pool(MAX_FRAME_SIZE)
+    , m_forwarded(0)
+    , m_dropped(0)
+    , m_link(nullptr)
+    , m_link_side(-1)
+    , m_link_event(false)
+    , m_link_notified(false)
+    , m_link_stop(false)
+{
+    SCP_TRACE(()) << "Constructor";
+
+    if (!p_pcap.get_value().empty() && !m_pcap.open(p_pcap.get_value())) {
+        SCP_ERR(()) << "Failed to open " << p_pcap.get_value() << ": " << strerror(errno);
+    }
+
+    SC_METHOD(deliver);
+    sensitive << m_deliver_event;
+    dont_initialize();
+
+    SC_METHOD(link_receive);
+    sensitive << m_link_event;
+    dont_initialize();
+
+    if (!p_shm_link.get_value().empty()) {
+        open_link(p_shm_link.get_value());
+    }
+}
+
+NetworkSwitch::~NetworkSwitch()
+{
+    /* stops and joins the polling thread before the link is unmapped */
+    close_link();
+    for (auto& queue : m_queues) {
+        for (Payload* frame : queue) {
+            m_pool.put(frame);
+        }
+    }
+}
+
+NetworkSwitch::Port* NetworkSwitch::add_port()
+{
+    m_ports.emplace_back(new Port(*this, m_ports.size()));
+    m_queues.emplace_back();
+    return m_ports.back().get();
+}
+
+void NetworkSwitch::forward(int from, const uint8_t* data, size_t len)
+{
+    if (len < 14 || len > MAX_FRAME_SIZE) {
+        SCP_DEBUG(()) << "dropping frame of size " << len;
+        m_dropped++;
+        return;
+    }
+    m_pcap.write(sc_time_stamp(), data, len);
+    m_forwarded++;
+
+    /* learn where the source is, unless it is a group address */
+    if (!(data[6] & 1)) {
+        m_fdb[mac_address(data + 6)] = from;
+    }
+
+    if (!(data[0] & 1)) {
+        auto it = m_fdb.find(mac_address(data));
+        if (it != m_fdb.end()) {
+            if (it->second != from) {
+                enqueue(it->second, data, len);
+            }
+            return;
+        }
+    }
+
+    SCP_TRACE(()) << "flooding frame of size " << len << " from port " << from;
+    for (int to = 0; to < int(m_ports.size()); to++) {
+        if (to != from) {
+            enqueue(to, data, len);
+        }
+    }
+    if (m_link && from != UPLINK) {
+        enqueue(UPLINK, data, len);
+    }
+}
+
+void NetworkSwitch::enqueue(int to, const uint8_t* data, size_t len)
+{
+    if (to == UPLINK) {
+        link_send(data, len);
+        return;
+    }
+    if (m_queues[to].size() >= p_queue_frames) {
+        SCP_DEBUG(()) << "port " << to << " queue full, dropping frame";
+        m_dropped++;
+        return;
+    }
+    Payload* frame = m_pool.get();
+    frame->resize(len);
+    memcpy(frame->data(), data, len);
+    m_queues[to].push_back(frame);
+    schedule_delivery();
+}
+
+void NetworkSwitch::schedule_delivery()
+{
+    const sc_core::sc_time& period = p_delivery_period.get_value();
+    if (period == sc_core::SC_ZERO_TIME) {
+        m_deliver_event.notify(sc_core::SC_ZERO_TIME);
+        return;
+    }
+    /* an earlier notification, already pending, is kept */
+    uint64_t now = sc_time_stamp().value();
+    m_deliver_event.notify(sc_core::sc_time::from_value(period.value() - now % period.value()));
+}
+
+void NetworkSwitch::deliver()
+{
+    bool retry = false;
+
+    for (size_t i = 0; i < m_ports.size(); i++) {
+        Port& port = *m_ports[i];
+        std::deque<Payload*>& queue = m_queues[i];
+
+        while (!queue.empty()) {
+            if (!port.attached()) {
+                m_dropped += queue.size();
+                for (Payload* frame : queue) {
+                    m_pool.put(frame);
+                }
+                queue.clear();
+                break;
+            }
+            if (!port.can_receive()) {
+                retry = true;
+                break;
+            }
+            Payload* frame = queue.front();
+            queue.pop_front();
+            port.receive(*frame);
+            m_pool.put(frame);
+        }
+    }
+
+    if (retry) {
+        /* notify myself later, hopefully the MAC is ready by then */
+        m_deliver_event.notify(sc_core::sc_time(1, sc_core::SC_MS));
+    }
+}
+
+void NetworkSwitch::open_link(const std::string& name)
+{
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        SCP_FATAL(()) << "Failed to open shared memory " << name << ": " << strerror(errno);
+    }
+    if (ftruncate(fd, sizeof(shm_link)) < 0) {
+        SCP_FATAL(()) << "Failed to size shared memory " << name << ": " << strerror(errno);
+    }
+    void* ptr = mmap(nullptr, sizeof(shm_link), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        SCP_FATAL(()) << "Failed to map shared memory " << name << ": " << strerror(errno);
+    }
+    m_link = static_cast<shm_link*>(ptr);
+
+    for (int side = 0; side < 2; side++) {
+        pid_t owner = m_link->attached[side].load();
+        if (owner != 0 && kill(owner, 0) < 0 && errno == ESRCH) {
+            SCP_WARN(()) << "Reclaiming side " << side << " of " << name << ", left by process " << owner;
+            m_link->attached[side].compare_exchange_strong(owner, 0);
+        }
+    }
+    for (int side = 0; side < 2; side++) {
+        pid_t detached = 0;
+        if (m_link->attached[side].compare_exchange_strong(detached, getpid())) {
+            m_link_side = side;
+            break;
+        }
+    }
+    if (m_link_side < 0) {
+        SCP_FATAL(()) << "Shared memory " << name << " already connects two switches";
+    }
+
+    /*
+     * The frames sent to a previous user of this side are dropped. Only the reader moves the tail, so this is safe
+     * even if the other side is sending. The head and tail are free running, they need no other reset.
+     */
+    shm_ring& ring = m_link->rings[1 - m_link_side];
+    ring.tail.store(ring.head.load(std::memory_order_acquire), std::memory_order_release);
+    SCP_INFO(()) << "Connected to " << name << " as side " << m_link_side;
+
+    /* the other simulator can send at any time, do not let this one end while waiting for it */
+    m_link_event.enable_attach_suspending(true);
+    m_link_thread = std::thread(&NetworkSwitch::link_poll, this);
+}
+
+void NetworkSwitch::close_link()
+{
+    if (!m_link) {
+        return;
+    }
+    m_link_stop = true;
+    if (m_link_thread.joinable()) {
+        m_link_thread.join();
+    }
+    m_link->attached[m_link_side] = 0;
+    if (m_link->attached[1 - m_link_side] == 0) {
+        shm_unlink(p_shm_link.get_value().c_str());
+    }
+    munmap(m_link, sizeof(shm_link));
+    m_link = nullptr;
+}
+
+void NetworkSwitch::link_send(const uint8_t* data, size_t len)
+{
+    shm_ring& ring = m_link->rings[m_link_side];
+    uint32_t head = ring.head.load(std::memory_order_relaxed);
+
+    if (head - ring.tail.load(std::memory_order_acquire) >= shm_ring::SLOTS) {
+        SCP_DEBUG(()) << "shared memory link full, dropping frame";
+        m_dropped++;
+        return;
+    }
+    auto& slot = ring.slots[head % shm_ring::SLOTS];
+    slot.len = len;
+    memcpy(slot.data, data, len);
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+void NetworkSwitch::link_receive()
+{
+    shm_ring& ring = m_link->rings[1 - m_link_side];
+
+    m_link_notified = false;
+    uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+    while (tail != ring.head.load(std::memory_order_acquire)) {
+        auto& slot = ring.slots[tail % shm_ring::SLOTS];
+        forward(UPLINK, slot.data, slot.len);
+        ring.tail.store(++tail, std::memory_order_release);
+    }
+}
+
+/* Runs in its own thread, wakes the SystemC side up when the other simulator sent frames */
+void NetworkSwitch::link_poll()
+{
+    shm_ring& ring = m_link->rings[1 - m_link_side];
+
+    while (!m_link_stop) {
+        if (ring.head.load(std::memory_order_acquire) != ring.tail.load(std::memory_order_relaxed) &&
+            !m_link_notified.exchange(true)) {
+            m_link_event.async_notify();
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
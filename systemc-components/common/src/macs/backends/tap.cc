@@ -32,7 +32,7 @@
 
 using namespace sc_core;
 
-NetworkBackendTap::NetworkBackendTap(sc_core::sc_module_name name, std::string tun): sc_module(name)
+NetworkBackendTap::NetworkBackendTap(sc_core::sc_module_name name, std::string tun): sc_module(name), m_pool(9000)
 {
     SCP_TRACE(SCMOD) << "Constructor";
     m_fd = -1;
@@ -81,7 +81,7 @@ void NetworkBackendTap::close()
 void* NetworkBackendTap::rcv_thread()
 {
     for (;;) {
-        Payload* frame = new Payload(9000);
+        Payload* frame = m_pool.get();
 
         int r = ::read(m_fd, frame->data(), (int)frame->capacity());
         if (r > 0) {
@@ -96,7 +96,7 @@ void* NetworkBackendTap::rcv_thread()
             frame->resize(r);
         } else {
             /* error */
-            delete frame;
+            m_pool.put(frame);
         }
 
         std::lock_guard<std::mutex> lock(m_mutex);
@@ -122,7 +122,7 @@ void NetworkBackendTap::rcv()
             frame = m_queue.front();
             m_queue.pop();
             m_receive(m_opaque, *frame);
-            delete frame;
+            m_pool.put(frame);
         } else {
             /* notify myself later, hopefully the queue drains */
             m_event.notify(sc_core::sc_time(1, sc_core::SC_MS));
@@ -382,10 +382,14 @@ protected:
 
     sc_core::sc_event m_tx_event;
     sc_core::sc_event intr_wake;
+    sc_core::sc_event m_rx_flush_event;
+    /* interrupts of the frames whose descriptors are not written back yet */
+    uint32_t m_pending_interrupts = 0;
 
     void reset();
 
     void interrupts_fire(uint32_t interrupts);
+    void interrupts_flush();
     void interrupts_clear(uint32_t interrupts);
 
     bool read_tx_desc(dma_desc* desc);
@@ -398,6 +402,7 @@ protected:
 
     void tx_thread();
     void intr_thread();
+    void rx_flush();
 
     /* DMA registers */
     static const uint32_t DMA_BUS_MODE = 0x1000;
@@ -490,6 +495,8 @@ public:
     tlm_utils::simple_target_socket<dwmac, DEFAULT_TLM_BUSWIDTH> socket;
     dma dma_inst;
     phy phy_inst;
+    desc_ring_batch m_tx_ring;
+    desc_ring_batch m_rx_ring;
 
     NetworkBackend* m_backend;
     void set_backend(NetworkBackend* backend)
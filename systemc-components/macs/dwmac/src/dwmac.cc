@@ -22,6 +22,8 @@ dwmac::dwmac(sc_module_name name)
     , socket("socket")
     , dma_inst("dma")
     , phy_inst("phy", 0x00010001, 0)
+    , m_tx_ring(dma_inst)
+    , m_rx_ring(dma_inst)
     , m_tx_frame(9018u)
 {
     reset();
@@ -45,6 +47,9 @@ dwmac::dwmac(sc_module_name name)
 
     SC_THREAD(tx_thread);
     SC_THREAD(intr_thread);
+    SC_METHOD(rx_flush);
+    sensitive << m_rx_flush_event;
+    dont_initialize();
 }
 
 dwmac::~dwmac() {}
@@ -429,7 +434,19 @@ void dwmac::write_word(uint32_t address, uint32_t data)
 
 void dwmac::interrupts_fire(uint32_t interrupts)
 {
-    m_dma.intr.fire(interrupts);
+    m_pending_interrupts |= interrupts;
+    interrupts_flush();
+}
+
+void dwmac::interrupts_flush()
+{
+    /* the guest must find the descriptors written back when it sees the interrupt */
+    m_tx_ring.flush();
+    m_rx_ring.flush();
+    if (m_pending_interrupts) {
+        m_dma.intr.fire(m_pending_interrupts);
+        m_pending_interrupts = 0;
+    }
     intr_wake.notify();
 }
 
@@ -441,6 +458,7 @@ void dwmac::reset()
     m_dma.rx_desc_addr = 0x00000000;
     m_dma.tx_desc_addr = 0x00000000;
     m_dma.intr.reset();
+    m_pending_interrupts = 0;
     m_dma.opr_mode.value = 0x00000000;
     m_dma.counters = 0x00000000;
     m_dma.current_tx_desc = 0x00000000;
@@ -464,7 +482,7 @@ void dwmac::reset()
 
 bool dwmac::read_tx_desc(dma_desc* desc)
 {
-    dma_inst.bus_read(m_dma.current_tx_desc, (uint8_t*)desc, m_dma.desc_size());
+    m_tx_ring.read(m_dma.current_tx_desc, desc, m_dma.desc_size());
 
     if (!desc->des01.etx.own) return false;
 
@@ -473,7 +491,7 @@ bool dwmac::read_tx_desc(dma_desc* desc)
 
 bool dwmac::read_rx_desc(dma_desc* desc)
 {
-    dma_inst.bus_read(m_dma.current_rx_desc, (uint8_t*)desc, m_dma.desc_size());
+    m_rx_ring.read(m_dma.current_rx_desc, desc, m_dma.desc_size());
 
     // clear status ?
     // desc->des01.rx &= 0x80000000;
@@ -550,7 +568,7 @@ bool dwmac::tx()
     m_dma.intr.setTxState(DwmacState::TX_READING);
 
     m_tx_frame.resize(desc.des01.etx.buffer1_size);
-    dma_inst.bus_read(desc.des2, m_tx_frame.data(), desc.des01.etx.buffer1_size);
+    dma_inst.read(desc.des2, m_tx_frame.data(), desc.des01.etx.buffer1_size);
 
     // fetching the whole frame
     while (!desc.des01.etx.last_segment) {
@@ -560,7 +578,7 @@ bool dwmac::tx()
 
         // disown descriptor
         desc.des01.etx.own = 0;
-        dma_inst.bus_write(cur_desc_addr, (uint8_t*)&desc, m_dma.desc_size());
+        m_tx_ring.write(cur_desc_addr, &desc, m_dma.desc_size());
 
         // read next descriptor
         if (!read_tx_desc(&desc)) {
@@ -569,7 +587,7 @@ bool dwmac::tx()
         }
         int offset = m_tx_frame.size();
         m_tx_frame.resize(offset + desc.des01.etx.buffer1_size);
-        dma_inst.bus_read(desc.des2, m_tx_frame.data() + offset, desc.des01.etx.buffer1_size);
+        dma_inst.read(desc.des2, m_tx_frame.data() + offset, desc.des01.etx.buffer1_size);
     }
 
     if (m_tx_frame.size() < 14) {
@@ -652,11 +670,12 @@ bool dwmac::tx()
 
     // disown descriptor
     desc.des01.etx.own = 0;
-    dma_inst.bus_write(m_dma.current_tx_desc, (uint8_t*)&desc, m_dma.desc_size());
+    m_tx_ring.write(m_dma.current_tx_desc, &desc, m_dma.desc_size());
 
     move_to_next_tx_desc(desc);
 
-    if (desc.des01.etx.interrupt) interrupts_fire(InterruptRegister::TxInt);
+    /* raised by tx_thread once the whole batch is written back */
+    if (desc.des01.etx.interrupt) m_pending_interrupts |= InterruptRegister::TxInt;
 
     m_dma.intr.setTxState(DwmacState::TX_SUSPENDED);
     return true;
@@ -693,7 +712,7 @@ bool dwmac::rx(Payload& frame)
         return false;
     }
 
-    dma_inst.bus_write(desc.des2, frame.data(), (int)frame.size());
+    dma_inst.write(desc.des2, frame.data(), (int)frame.size());
 
     m_dma.intr.setRxState(DwmacState::RX_CLOSING);
     desc.des01.erx.first_descriptor = 1;
@@ -704,7 +723,7 @@ bool dwmac::rx(Payload& frame)
     desc.des01.erx.rx_mac_addr = 0; // extended status not available (we would need to implement it)
 
     desc.des01.erx.own = 0;
-    dma_inst.bus_write(m_dma.current_rx_desc, (uint8_t*)&desc, m_dma.desc_size());
+    m_rx_ring.write(m_dma.current_rx_desc, &desc, m_dma.desc_size());
 
     SCP_TRACE(SCMOD) << "moving to the next RX descriptor";
 
@@ -719,11 +738,13 @@ bool dwmac::rx(Payload& frame)
         }
     }
 
+    /* the frames received in this delta cycle are written back and signalled together by rx_flush */
     if (!desc.des01.erx.disable_ic) {
-        interrupts_fire(InterruptRegister::RxInt);
+        m_pending_interrupts |= InterruptRegister::RxInt;
     } else {
         SCP_DEBUG(SCMOD) << "erx: disabled_ic is set";
     }
+    m_rx_flush_event.notify(sc_core::SC_ZERO_TIME);
 
     m_dma.intr.setRxState(DwmacState::RX_SUSPENDED);
     return true;
@@ -736,6 +757,7 @@ void dwmac::tx_thread()
         if (m_dma.intr.getTxState() != DwmacState::TX_STOPPED) {
             while (tx())
                 ; // consume all packets in the queue
+            interrupts_flush();
         }
     }
 }
@@ -748,6 +770,8 @@ void dwmac::payload_recv(Payload& frame)
     }
 }
 
+void dwmac::rx_flush() { interrupts_flush(); }
+
 void dwmac::intr_thread()
 {
     for (;;) {
@@ -49,8 +49,13 @@ public:
     dma m_dma;
 
 protected:
+    desc_ring_batch m_tx_ring;
+    desc_ring_batch m_rx_ring;
+
     RxTxStats m_stats;
     uint32_t m_regs[R_MAX];
+    /* DMA_STATUS bits of the received frames whose descriptors are not written back yet */
+    uint32_t m_rx_pending_status = 0;
 
     bool eth_can_rx() const;
     ssize_t eth_rx(const uint8_t* buf, size_t size);
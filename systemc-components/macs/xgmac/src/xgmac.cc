@@ -101,6 +101,8 @@ xgmac::xgmac(sc_module_name name)
     , mci_irq("mci_irq")
     , socket("socket")
     , m_dma("dma")
+    , m_tx_ring(m_dma)
+    , m_rx_ring(m_dma)
     , m_regs()
     , m_tx_frame(9018u)
 {
@@ -154,7 +156,7 @@ ssize_t xgmac::eth_rx(const uint8_t* buf, size_t size)
         goto out;
     }
 
-    m_dma.bus_write(((bd.buffer2_addr << 32) | bd.buffer1_addr), (uint8_t*)buf, size);
+    m_dma.write(((bd.buffer2_addr << 32) | bd.buffer1_addr), buf, size);
 
     /* Add in the 4 bytes for crc (the real hw returns length incl crc) */
     size += 4;
@@ -169,8 +171,10 @@ ssize_t xgmac::eth_rx(const uint8_t* buf, size_t size)
         m_stats.rx_bcast++;
     }
 
-    m_regs[DMA_STATUS] |= DMA_STATUS_RI | DMA_STATUS_NIS;
-    ret = size;
+    /* the frames received in this delta cycle are written back and signalled together */
+    m_rx_pending_status |= DMA_STATUS_RI | DMA_STATUS_NIS;
+    update_event.notify(sc_core::SC_ZERO_TIME);
+    return size;
 
 out:
     enet_update_irq();
@@ -184,7 +188,7 @@ void xgmac::xgmac_read_desc(XGmacDesc* d, int rx)
     uint32_t addr = rx ? m_regs[DMA_CUR_RX_DESC_ADDR] : m_regs[DMA_CUR_TX_DESC_ADDR];
 
     SCP_TRACE(SCMOD) << "Reading XGmacDesc at addr " << std::hex << addr;
-    m_dma.bus_read(addr, (uint8_t*)d, sizeof(*d));
+    (rx ? m_rx_ring : m_tx_ring).read(addr, d, sizeof(*d));
 }
 
 void xgmac::xgmac_write_desc(XGmacDesc* d, int rx)
@@ -200,18 +204,16 @@ void xgmac::xgmac_write_desc(XGmacDesc* d, int rx)
         m_regs[reg] += sizeof(*d);
     }
 
-    m_dma.bus_write(addr, (uint8_t*)d, sizeof(*d));
+    (rx ? m_rx_ring : m_tx_ring).write(addr, d, sizeof(*d));
 }
 
 void xgmac::xgmac_enet_send()
 {
     XGmacDesc bd;
-    int frame_size;
-    int len;
-    uint8_t frame[8192];
-    uint8_t* ptr;
+    size_t frame_size;
+    size_t len;
+    uint32_t status = 0;
 
-    ptr = frame;
     frame_size = 0;
     while (1) {
         xgmac_read_desc(&bd, 0);
@@ -229,36 +231,41 @@ void xgmac::xgmac_enet_send()
             SCP_ERR(SCMOD) << __func__ << ":ERROR...ERROR...ERROR... -- xgmac buffer 2 len on send > 2048 (0x"
                            << std::hex << bd.buffer2_size << ")";
         }
-        if (size_t(len) >= sizeof(frame)) {
-            SCP_ERR(SCMOD) << __func__ << ": buffer overflow " << len << " read into " << sizeof(frame);
+        if (frame_size + len > m_tx_frame.capacity()) {
+            SCP_ERR(SCMOD) << __func__ << ": buffer overflow " << len << " read into " << m_tx_frame.capacity();
             SCP_ERR(SCMOD) << __func__ << ": buffer1.size=" << bd.buffer1_size << "; buffer2.size=" << bd.buffer2_size;
+            len = m_tx_frame.capacity() - frame_size;
         }
 
-        m_dma.bus_read(((bd.buffer2_addr << 32) | bd.buffer1_addr), ptr, len);
-        ptr += len;
+        /* the buffers are gathered straight into the frame handed to the backend */
+        m_tx_frame.resize(frame_size + len);
+        m_dma.read(((bd.buffer2_addr << 32) | bd.buffer1_addr), m_tx_frame.data() + frame_size, len);
         frame_size += len;
         if (bd.ctl_stat & 0x20000000) {
             /* Last buffer in frame.  */
             SCP_TRACE(SCMOD) << "Last buffer in frame, sending. Size: " << frame_size;
-            m_tx_frame.resize(frame_size);
-            memcpy(m_tx_frame.data(), frame, frame_size);
             m_backend->send(m_tx_frame);
 
-            ptr = frame;
             frame_size = 0;
-            m_regs[DMA_STATUS] |= DMA_STATUS_TI | DMA_STATUS_NIS;
+            status |= DMA_STATUS_TI | DMA_STATUS_NIS;
         }
         bd.ctl_stat &= ~0x80000000;
 
         /* Write back the modified descriptor.  */
         xgmac_write_desc(&bd, 0);
     }
+    /* the guest must find the descriptors written back when it sees TI */
+    m_tx_ring.flush();
+    m_regs[DMA_STATUS] |= status;
 }
 
 void xgmac::enet_update_irq() { update_event.notify(); }
 
 void xgmac::enet_update_irq_sysc()
 {
+    m_rx_ring.flush();
+    m_regs[DMA_STATUS] |= m_rx_pending_status;
+    m_rx_pending_status = 0;
     int stat = m_regs[DMA_STATUS] & m_regs[DMA_INTR_ENA];
     sbd_irq = !!stat;
 }
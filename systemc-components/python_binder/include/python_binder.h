@@ -40,6 +40,9 @@
 #include <uutils.h>
 #include <pybind11/pybind11.h>
 #include <tuple>
+#include <deque>
+#include <memory>
+#include <map>
 #include <unordered_map>
 #include <thread>
 #include <future>
@@ -52,15 +55,25 @@ namespace gs {
 unsigned char* get_pybind11_buffer_info_ptr(const pybind11::buffer& bytes);
 
 std::string txn_command_str(const tlm::tlm_generic_payload& trans);
+
+/**
+ * The data and byte enable buffers alias the memory of the transaction, with no copy. A transaction received by the
+ * python model is only valid for the duration of the call, new buffers can't be requested once it returned.
+ */
 class generic_payload_data_buf
 {
 private:
     tlm::tlm_generic_payload* txn;
+    std::shared_ptr<bool> valid;
 
 public:
-    generic_payload_data_buf(tlm::tlm_generic_payload* _txn): txn(_txn) {}
+    generic_payload_data_buf(tlm::tlm_generic_payload* _txn, std::shared_ptr<bool> _valid)
+        : txn(_txn), valid(_valid)
+    {
+    }
     pybind11::buffer_info get_buffer()
     {
+        if (!*valid) throw pybind11::buffer_error("transaction data used after the end of the call");
         return pybind11::buffer_info(txn->get_data_ptr(), sizeof(uint8_t),
                                      pybind11::format_descriptor<uint8_t>::format(), 1,
                                      { static_cast<ssize_t>(txn->get_data_length()) }, { sizeof(uint8_t) });
@@ -71,32 +84,76 @@ class generic_payload_be_buf
 {
 private:
     tlm::tlm_generic_payload* txn;
+    std::shared_ptr<bool> valid;
 
 public:
-    generic_payload_be_buf(tlm::tlm_generic_payload* _txn): txn(_txn) {}
+    generic_payload_be_buf(tlm::tlm_generic_payload* _txn, std::shared_ptr<bool> _valid): txn(_txn), valid(_valid) {}
     pybind11::buffer_info get_buffer()
     {
+        if (!*valid) throw pybind11::buffer_error("transaction byte enables used after the end of the call");
         return pybind11::buffer_info(txn->get_byte_enable_ptr(), sizeof(uint8_t),
                                      pybind11::format_descriptor<uint8_t>::format(), 1,
                                      { static_cast<ssize_t>(txn->get_byte_enable_length()) }, { sizeof(uint8_t) });
     }
 };
 
+/**
+ * A DMI region granted to the python model, its buffer aliases the memory of the target. It is invalidated, and no
+ * new buffer can be requested, when the target invalidates an overlapping range.
+ */
+class tlm_dmi_wrapper
+{
+private:
+    tlm::tlm_dmi dmi;
+    bool valid;
+
+public:
+    tlm_dmi_wrapper(): valid(true) {}
+
+    tlm::tlm_dmi& get_dmi() { return dmi; }
+    void invalidate() { valid = false; }
+    bool is_valid() const { return valid; }
+
+    sc_dt::uint64 get_start_address() const { return dmi.get_start_address(); }
+    sc_dt::uint64 get_end_address() const { return dmi.get_end_address(); }
+    bool is_read_allowed() const { return dmi.is_read_allowed(); }
+    bool is_write_allowed() const { return dmi.is_write_allowed(); }
+    sc_core::sc_time get_read_latency() const { return dmi.get_read_latency(); }
+    sc_core::sc_time get_write_latency() const { return dmi.get_write_latency(); }
+
+    /* Only new exports are refused after an invalidation, views exported before keep aliasing the target memory */
+    pybind11::buffer_info get_buffer()
+    {
+        if (!valid) throw pybind11::buffer_error("DMI region used after being invalidated");
+        return pybind11::buffer_info(dmi.get_dmi_ptr(), sizeof(uint8_t), pybind11::format_descriptor<uint8_t>::format(),
+                                     1, { static_cast<ssize_t>(dmi.get_end_address() - dmi.get_start_address() + 1) },
+                                     { sizeof(uint8_t) }, !dmi.is_write_allowed());
+    }
+};
+
 class tlm_generic_payload_wrapper
 {
 private:
     tlm::tlm_generic_payload* txn;
     bool txn_created;
+    std::shared_ptr<bool> valid; // shared by the copies given to python
 
 public:
-    tlm_generic_payload_wrapper(tlm::tlm_generic_payload* _txn): txn(_txn), txn_created(false) {}
-    tlm_generic_payload_wrapper(): txn_created(true) { txn = new tlm::tlm_generic_payload(); }
+    tlm_generic_payload_wrapper(tlm::tlm_generic_payload* _txn)
+        : txn(_txn), txn_created(false), valid(std::make_shared<bool>(true))
+    {
+    }
+    tlm_generic_payload_wrapper(): txn_created(true), valid(std::make_shared<bool>(true))
+    {
+        txn = new tlm::tlm_generic_payload();
+    }
     ~tlm_generic_payload_wrapper()
     {
         if (txn_created) delete txn;
     }
 
     tlm::tlm_generic_payload* get_payload() { return txn; }
+    void invalidate() { *valid = false; }
 
     bool is_read() const { return txn->is_read(); }
     void set_read() { txn->set_read(); }
@@ -111,7 +168,7 @@ public:
         unsigned char* data = get_pybind11_buffer_info_ptr(bytes);
         std::memcpy(txn->get_data_ptr(), data, txn->get_data_length());
     }
-    generic_payload_data_buf get_data() { return generic_payload_data_buf(txn); }
+    generic_payload_data_buf get_data() { return generic_payload_data_buf(txn, valid); }
     void set_data_ptr(const pybind11::buffer& bytes)
     {
         unsigned char* data = get_pybind11_buffer_info_ptr(bytes);
@@ -132,14 +189,14 @@ public:
     void set_byte_enable_ptr(const pybind11::buffer& bytes)
     {
         unsigned char* byte_enable = get_pybind11_buffer_info_ptr(bytes);
-        txn->set_data_ptr(byte_enable);
+        txn->set_byte_enable_ptr(byte_enable);
     }
     void set_byte_enable(const pybind11::buffer& bytes)
     {
         unsigned char* byte_enable = get_pybind11_buffer_info_ptr(bytes);
         std::memcpy(txn->get_byte_enable_ptr(), byte_enable, txn->get_byte_enable_length());
     }
-    generic_payload_be_buf get_byte_enable() { return generic_payload_be_buf(txn); }
+    generic_payload_be_buf get_byte_enable() { return generic_payload_be_buf(txn, valid); }
 
     unsigned int get_byte_enable_length() const { return txn->get_byte_enable_length(); }
     void set_byte_enable_length(const unsigned int byte_enable_length)
@@ -178,8 +235,27 @@ class PYTHON_BINDER_API python_binder : public sc_core::sc_module, public sc_cor
                                                                         sc_core::SC_ZERO_OR_MORE_BOUND>;
     using tlm_target_socket_t = tlm_utils::simple_target_socket_tagged_b<MOD, BUSWIDTH, tlm::tlm_base_protocol_types,
                                                                          sc_core::SC_ZERO_OR_MORE_BOUND>;
-    using b_transport_info = std::tuple<tlm_generic_payload_wrapper, sc_core::sc_time,
-                                        std::shared_ptr<sc_core::sc_event>, std::shared_ptr<sc_core::sc_event>>;
+    /* A b_transport waiting for the python model, owned by the calling thread until done is notified */
+    struct pending_b_transport {
+        int id;
+        tlm_generic_payload_wrapper trans;
+        sc_core::sc_time delay;
+        const char* fn_name;
+        bool is_id_used;
+        sc_core::sc_event done;
+    };
+    /* The b_transport calls pending on one socket, served in order by their own dispatcher */
+    struct btspt_dispatcher {
+        std::deque<pending_b_transport*> queue;
+        sc_core::sc_event event;
+    };
+    /* A register declared by the python model, handled in C++ unless it has side effects */
+    struct py_register {
+        uint32_t size;
+        uint64_t value;
+        bool side_effects;
+        bool read_only;
+    };
     using b_transport_th_info = std::tuple<int, tlm_generic_payload_wrapper, sc_core::sc_time, bool, std::string,
                                            std::promise<void>>;
 
@@ -193,13 +269,20 @@ private:
 
     void setup_biflow_socket(pybind11::object& _modules);
 
+    void setup_register_map(pybind11::object& _modules);
+
+    py_register& find_register(int id, uint64_t offset);
+
+    bool registers_b_transport(int id, tlm::tlm_generic_payload& trans);
+
     void do_b_transport(int id, pybind11::object& py_trans, pybind11::object& py_delay);
 
+    pybind11::object do_get_direct_mem_ptr(int id, pybind11::object& py_trans);
+
     void b_transport(int id, tlm::tlm_generic_payload& trans, sc_core::sc_time& delay);
 
     void do_target_b_transport(int id, tlm::tlm_generic_payload& trans, sc_core::sc_time& delay,
-                               const std::string& tspt_name, std::unordered_map<int, b_transport_info>& cont,
-                               bool is_id_used);
+                               const std::string& tspt_name, bool is_id_used);
 
     void bf_b_transport(tlm::tlm_generic_payload& txn, sc_core::sc_time& delay);
 
@@ -221,9 +304,7 @@ private:
 
     void target_signal_cb(int id, bool value);
 
-    void exec_py_b_transport();
-
-    void exec_py_spawned_sc_thread();
+    void exec_py_b_transport(btspt_dispatcher& dispatcher);
 
     void stage_callback(const sc_core::sc_stage& stage) override;
 
@@ -251,8 +332,10 @@ private:
     pybind11::module_ m_biflow_socket_mod;
     pybind11::module_ m_initiator_signal_socket_mod;
     pybind11::module_ m_cpp_shared_vars_mod;
-    std::unordered_map<int, b_transport_info> m_btspt_cont;
-    std::unordered_map<int, b_transport_info> m_bftspt_cont;
+    pybind11::module_ m_register_map_mod;
+    std::vector<std::map<uint64_t, py_register>> m_registers; // per target socket, by offset
+    std::vector<std::weak_ptr<tlm_dmi_wrapper>> m_dmi_regions; // granted to python
+    std::vector<std::unique_ptr<btspt_dispatcher>> m_btspt_dispatchers; // per target socket, then biflow socket
     std::unordered_map<int, std::pair<bool, std::shared_ptr<sc_core::sc_event>>> m_target_signals_cont;
     std::unique_ptr<std::thread> m_btspt_method_thread;
     b_transport_th_info m_btspt_info;
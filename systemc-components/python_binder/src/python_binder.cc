@@ -12,6 +12,7 @@
 #include <pybind11/embed.h>
 #include <pybind11/functional.h>
 #include <pybind11/operators.h>
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <functional>
@@ -96,8 +97,8 @@ bool sc_thread_try_wait(pybind11::object obj, py_wait_type type)
     return false;
 }
 
-void exec_sc_thread_try_wait(pybind11::object obj, bool notify = false,
-                             std::shared_ptr<sc_core::sc_event> notifier = nullptr)
+/* returns true if the python function yielded, and will be called again once the wait is over */
+bool exec_sc_thread_try_wait(pybind11::object obj)
 {
     try {
         if (!sc_thread_try_wait(obj, py_wait_type::SC_EVENT) && !sc_thread_try_wait(obj, py_wait_type::SC_TIME) &&
@@ -108,7 +109,7 @@ void exec_sc_thread_try_wait(pybind11::object obj, bool notify = false,
                           << std::endl;
                 abort();
             }
-            if (notify) notifier->notify(sc_core::SC_ZERO_TIME);
+            return false;
         }
     } catch (pybind11::error_already_set& e) {
         if (!e.matches(PyExc_StopIteration)) {
@@ -117,12 +118,13 @@ void exec_sc_thread_try_wait(pybind11::object obj, bool notify = false,
         } else {
             // No more yield. so the next(thread_generator) will raise StopIteration
             // exception.
-            if (notify) notifier->notify(sc_core::SC_ZERO_TIME);
+            return false;
         }
     } catch (const std::exception& ex) {
         std::cerr << "C++ Exception: " << ex.what() << std::endl;
         throw;
     }
+    return true;
 }
 
 PYBIND11_EMBEDDED_MODULE(sc_core, m)
@@ -271,6 +273,16 @@ PYBIND11_EMBEDDED_MODULE(tlm_generic_payload, m)
     pybind11::class_<generic_payload_be_buf>(m, "generic_payload_be_buf", pybind11::buffer_protocol())
         .def_buffer(&generic_payload_be_buf::get_buffer);
 
+    pybind11::class_<tlm_dmi_wrapper, std::shared_ptr<tlm_dmi_wrapper>>(m, "tlm_dmi", pybind11::buffer_protocol())
+        .def_buffer(&tlm_dmi_wrapper::get_buffer)
+        .def("is_valid", &tlm_dmi_wrapper::is_valid)
+        .def("get_start_address", &tlm_dmi_wrapper::get_start_address)
+        .def("get_end_address", &tlm_dmi_wrapper::get_end_address)
+        .def("is_read_allowed", &tlm_dmi_wrapper::is_read_allowed)
+        .def("is_write_allowed", &tlm_dmi_wrapper::is_write_allowed)
+        .def("get_read_latency", &tlm_dmi_wrapper::get_read_latency)
+        .def("get_write_latency", &tlm_dmi_wrapper::get_write_latency);
+
     pybind11::class_<tlm_generic_payload_wrapper>(m, "tlm_generic_payload")
         .def(pybind11::init<>())
         .def("get_address", &tlm_generic_payload_wrapper::get_address)
@@ -321,8 +333,8 @@ python_binder<BUSWIDTH>::python_binder(const sc_core::sc_module_name& nm)
     , p_py_mod_args("py_module_args", "", "a string of command line arguments to be passed to the module")
     , p_py_mod_current_mod_id_prefix("current_mod_id_prefix", "",
                                      "prefix current instance specific module names: [cpp_shared_vars, "
-                                     "tlm_do_b_transport, initiator_signal_socket and "
-                                     "biflow_socket] with this parameter")
+                                     "tlm_do_b_transport, initiator_signal_socket, "
+                                     "biflow_socket and register_map] with this parameter")
     , p_tlm_initiator_ports_num("tlm_initiator_ports_num", 0, "number of tlm initiator ports")
     , p_tlm_target_ports_num("tlm_target_ports_num", 0, "number of tlm target ports")
     , p_initiator_signals_num("initiator_signals_num", 0, "number of initiator signals")
@@ -348,6 +360,7 @@ python_binder<BUSWIDTH>::python_binder(const sc_core::sc_module_name& nm)
                                   [this](const char* n, int i) { return new InitiatorSignalSocket<bool>(n); });
     target_signal_sockets.init(p_target_signals_num.get_value(),
                                [this](const char* n, int i) { return new TargetSignalSocket<bool>(n); });
+    m_registers.resize(p_tlm_target_ports_num.get_value());
     for (uint32_t i = 0; i < p_tlm_target_ports_num.get_value(); i++) {
         target_sockets[i].register_b_transport(this, &python_binder::b_transport, i);
         target_sockets[i].register_transport_dbg(this, &python_binder::transport_dbg, i);
@@ -360,6 +373,16 @@ python_binder<BUSWIDTH>::python_binder(const sc_core::sc_module_name& nm)
     for (uint32_t i = 0; i < p_target_signals_num.get_value(); i++) {
         target_signal_sockets[i].register_value_changed_cb([this, i](bool value) { target_signal_cb(i, value); });
     }
+    for (uint32_t i = 0; i < p_tlm_target_ports_num.get_value() + p_bf_socket_num.get_value(); i++) {
+        btspt_dispatcher* dispatcher = new btspt_dispatcher;
+        m_btspt_dispatchers.emplace_back(dispatcher);
+        sc_core::sc_spawn_options opts;
+        opts.spawn_method();
+        opts.dont_initialize();
+        opts.set_sensitivity(&dispatcher->event);
+        sc_core::sc_spawn([this, dispatcher]() { exec_py_b_transport(*dispatcher); },
+                          ("py_b_transport_" + std::to_string(i)).c_str(), &opts);
+    }
     sc_core::sc_register_stage_callback(*this, sc_core::SC_POST_UPDATE);
 
     gs::SigHandler::get().add_sigint_handler(gs::Handler_CB::PASS);
@@ -421,10 +444,14 @@ void python_binder<BUSWIDTH>::init_binder()
             [this](int id, pybind11::object& py_trans, pybind11::object& delay) {
                 do_b_transport(id, py_trans, delay);
             });
+        m_tlm_do_b_transport_mod.attr("get_direct_mem_ptr") = pybind11::cpp_function(
+            [this](int id, pybind11::object& py_trans) { return do_get_direct_mem_ptr(id, py_trans); });
         modules.attr("setdefault")(m_tlm_do_b_transport_mod_name.c_str(), m_tlm_do_b_transport_mod);
 
         setup_biflow_socket(modules);
 
+        setup_register_map(modules);
+
         std::string m_initiator_signal_socket_mod_name = (p_py_mod_current_mod_id_prefix.get_value().empty()
                                                               ? std::string("initiator_signal_socket")
                                                               : p_py_mod_current_mod_id_prefix.get_value() +
@@ -477,6 +504,88 @@ void python_binder<BUSWIDTH>::setup_biflow_socket(pybind11::object& _modules)
     _modules.attr("setdefault")(m_biflow_socket_mod_name.c_str(), m_biflow_socket_mod);
 }
 
+template <unsigned int BUSWIDTH>
+void python_binder<BUSWIDTH>::setup_register_map(pybind11::object& _modules)
+{
+    std::string m_register_map_mod_name = (p_py_mod_current_mod_id_prefix.get_value().empty()
+                                               ? std::string("register_map")
+                                               : p_py_mod_current_mod_id_prefix.get_value() +
+                                                     std::string("register_map"));
+    m_register_map_mod = pybind11::module_::import("types").attr("ModuleType")(m_register_map_mod_name.c_str());
+    m_register_map_mod.attr("add_register") = pybind11::cpp_function(
+        [this](int id, uint64_t offset, uint32_t size, uint64_t value, bool side_effects, bool read_only) {
+            if (id < 0 || id >= (int)m_registers.size()) {
+                throw std::out_of_range("no target socket " + std::to_string(id));
+            }
+            if (size != 1 && size != 2 && size != 4 && size != 8) {
+                throw std::invalid_argument("register size must be 1, 2, 4 or 8 bytes");
+            }
+            auto& regs = m_registers[id];
+            auto next = regs.lower_bound(offset);
+            if ((next != regs.end() && next->first < offset + size) ||
+                (next != regs.begin() && std::prev(next)->first + std::prev(next)->second.size > offset)) {
+                throw std::invalid_argument("register overlaps an existing one");
+            }
+            uint64_t mask = (size == 8) ? ~0ULL : ((1ULL << (size * 8)) - 1);
+            regs[offset] = { size, value & mask, side_effects, read_only };
+        },
+        pybind11::arg("id"), pybind11::arg("offset"), pybind11::arg("size"), pybind11::arg("value") = 0,
+        pybind11::arg("side_effects") = false, pybind11::arg("read_only") = false);
+    m_register_map_mod.attr("read") = pybind11::cpp_function(
+        [this](int id, uint64_t offset) { return find_register(id, offset).value; });
+    m_register_map_mod.attr("write") = pybind11::cpp_function([this](int id, uint64_t offset, uint64_t value) {
+        py_register& reg = find_register(id, offset);
+        reg.value = (reg.size == 8) ? value : (value & ((1ULL << (reg.size * 8)) - 1));
+    });
+    _modules.attr("setdefault")(m_register_map_mod_name.c_str(), m_register_map_mod);
+}
+
+template <unsigned int BUSWIDTH>
+typename python_binder<BUSWIDTH>::py_register& python_binder<BUSWIDTH>::find_register(int id, uint64_t offset)
+{
+    if (id >= 0 && id < (int)m_registers.size()) {
+        auto it = m_registers[id].find(offset);
+        if (it != m_registers[id].end()) return it->second;
+    }
+    throw std::out_of_range("no register at offset " + std::to_string(offset) + " of target socket " +
+                            std::to_string(id));
+}
+
+/**
+ * Accesses within a register declared without side effects are served from its stored value, without calling into
+ * python. The value is kept in host byte order, as the data of the transactions.
+ */
+template <unsigned int BUSWIDTH>
+bool python_binder<BUSWIDTH>::registers_b_transport(int id, tlm::tlm_generic_payload& trans)
+{
+    auto& regs = m_registers[id];
+    if (regs.empty() || trans.get_byte_enable_ptr() || trans.get_streaming_width() < trans.get_data_length()) {
+        return false;
+    }
+    uint64_t addr = trans.get_address();
+    unsigned int len = trans.get_data_length();
+    auto it = regs.upper_bound(addr);
+    if (it == regs.begin()) return false;
+    --it;
+    py_register& reg = it->second;
+    uint64_t offset = addr - it->first;
+    if (reg.side_effects || offset + len > reg.size) return false;
+
+    unsigned char* value = reinterpret_cast<unsigned char*>(&reg.value) + offset;
+    switch (trans.get_command()) {
+    case tlm::TLM_READ_COMMAND:
+        std::memcpy(trans.get_data_ptr(), value, len);
+        break;
+    case tlm::TLM_WRITE_COMMAND:
+        if (!reg.read_only) std::memcpy(value, trans.get_data_ptr(), len);
+        break;
+    default:
+        break;
+    }
+    trans.set_response_status(tlm::TLM_OK_RESPONSE);
+    return true;
+}
+
 template <unsigned int BUSWIDTH>
 void python_binder<BUSWIDTH>::do_b_transport(int id, pybind11::object& py_trans, pybind11::object& py_delay)
 {
@@ -487,6 +596,24 @@ void python_binder<BUSWIDTH>::do_b_transport(int id, pybind11::object& py_trans,
     initiator_sockets[id]->b_transport(*trans, *delay);
 }
 
+template <unsigned int BUSWIDTH>
+pybind11::object python_binder<BUSWIDTH>::do_get_direct_mem_ptr(int id, pybind11::object& py_trans)
+{
+    tlm::tlm_generic_payload* trans = py_trans.cast<tlm_generic_payload_wrapper*>()->get_payload();
+    SCP_DEBUG(()) << "get_direct_mem_ptr using initiator_socket_" << id << " addr: 0x" << std::hex
+                  << trans->get_address();
+    auto region = std::make_shared<tlm_dmi_wrapper>();
+    if (!initiator_sockets[id]->get_direct_mem_ptr(*trans, region->get_dmi())) {
+        return pybind11::none();
+    }
+    /* regions python dropped are only forgotten here, or when invalidated */
+    m_dmi_regions.erase(std::remove_if(m_dmi_regions.begin(), m_dmi_regions.end(),
+                                       [](const std::weak_ptr<tlm_dmi_wrapper>& r) { return r.expired(); }),
+                        m_dmi_regions.end());
+    m_dmi_regions.push_back(region);
+    return pybind11::cast(region);
+}
+
 template <unsigned int BUSWIDTH>
 void python_binder<BUSWIDTH>::stage_callback(const sc_core::sc_stage& stage)
 {
@@ -515,40 +642,44 @@ void python_binder<BUSWIDTH>::method_thread()
     }
 }
 
+/**
+ * Serves the b_transport calls pending on one socket with a single GIL acquisition. If the model yields, the same
+ * call is resumed once the wait is over, before the next ones of this socket; the other sockets have their own
+ * dispatcher and are not held up.
+ */
+template <unsigned int BUSWIDTH>
+void python_binder<BUSWIDTH>::exec_py_b_transport(btspt_dispatcher& dispatcher)
+{
+    pybind11::gil_scoped_acquire gil;
+    while (!dispatcher.queue.empty()) {
+        pending_b_transport* p = dispatcher.queue.front();
+        pybind11::object ret;
+        if (p->is_id_used) {
+            ret = m_main_mod.attr(p->fn_name)(p->id, p->trans, p->delay);
+        } else {
+            ret = m_main_mod.attr(p->fn_name)(p->trans, p->delay);
+        }
+        if (exec_sc_thread_try_wait(ret)) return;
+        dispatcher.queue.pop_front();
+        p->done.notify(sc_core::SC_ZERO_TIME);
+    }
+}
+
 template <unsigned int BUSWIDTH>
 void python_binder<BUSWIDTH>::do_target_b_transport(int id, tlm::tlm_generic_payload& trans, sc_core::sc_time& delay,
-                                                    const std::string& tspt_name,
-                                                    std::unordered_map<int, b_transport_info>& cont, bool is_id_used)
+                                                    const std::string& tspt_name, bool is_id_used)
 {
     tlm_generic_payload_wrapper ptrans(&trans);
     if (sc_core::sc_get_curr_process_kind() != sc_core::sc_curr_proc_kind::SC_METHOD_PROC_) {
-        if (cont.find(id) == cont.end()) {
-            cont[id] = std::make_tuple(ptrans, delay, std::make_shared<sc_core::sc_event>(),
-                                       std::make_shared<sc_core::sc_event>());
-            sc_core::sc_spawn_options opts;
-            opts.spawn_method();
-            opts.dont_initialize();
-            opts.set_sensitivity(std::get<3>(cont[id]).get());
-            sc_core::sc_spawn(
-                [this, &cont, id, tspt_name, is_id_used]() {
-                    pybind11::gil_scoped_acquire gil;
-                    const auto& [ptrans, pdelay, notifier_ev, ignored_ev] = cont[id];
-                    pybind11::object ret;
-                    if (is_id_used) {
-                        ret = m_main_mod.attr(tspt_name.c_str())(id, ptrans, pdelay);
-                    } else {
-                        ret = m_main_mod.attr(tspt_name.c_str())(ptrans, pdelay);
-                    }
-                    exec_sc_thread_try_wait(ret, true, notifier_ev);
-                },
-                std::string(tspt_name + std::to_string(id)).c_str(), &opts);
-        } else {
-            std::get<0>(cont[id]) = ptrans;
-            std::get<1>(cont[id]) = delay;
+        /* the biflow socket calls are not given an id, their dispatcher comes after the target sockets' */
+        btspt_dispatcher& dispatcher = is_id_used ? *m_btspt_dispatchers[id] : *m_btspt_dispatchers.back();
+        pending_b_transport pending{ id, ptrans, delay, tspt_name.c_str(), is_id_used };
+        dispatcher.queue.push_back(&pending);
+        dispatcher.event.notify(sc_core::SC_ZERO_TIME);
+        {
+            pybind11::gil_scoped_release gil_release;
+            wait(pending.done);
         }
-        pybind11::gil_scoped_release gil_release;
-        std::get<3>(cont[id])->notify(sc_core::SC_ZERO_TIME);
-        wait(*(std::get<2>(cont[id])));
     } else {
         std::promise<void> btspt_p;
         auto fut = btspt_p.get_future();
@@ -565,18 +696,22 @@ void python_binder<BUSWIDTH>::do_target_b_transport(int id, tlm::tlm_generic_pay
             std::lock_guard<std::mutex> lg(m_btspt_mutex);
             m_btspt_ready = true;
         }
-        pybind11::gil_scoped_release gil_release;
-        m_btspt_cv.notify_one();
-        fut.wait();
+        {
+            pybind11::gil_scoped_release gil_release;
+            m_btspt_cv.notify_one();
+            fut.wait();
+        }
     }
+    ptrans.invalidate();
 }
 
 template <unsigned int BUSWIDTH>
 void python_binder<BUSWIDTH>::b_transport(int id, tlm::tlm_generic_payload& trans, sc_core::sc_time& delay)
 {
+    if (registers_b_transport(id, trans)) return;
     SCP_DEBUG(()) << "before b_transport " << txn_command_str(trans) << " on target_socket_" << id << " trans addr: 0x"
                   << std::hex << trans.get_address();
-    do_target_b_transport(id, trans, delay, "b_transport", m_btspt_cont, true);
+    do_target_b_transport(id, trans, delay, "b_transport", true);
     SCP_DEBUG(()) << "after b_transport " << txn_command_str(trans) << " on target_socket_" << id << " trans addr: 0x"
                   << std::hex << trans.get_address();
 }
@@ -586,7 +721,7 @@ void python_binder<BUSWIDTH>::bf_b_transport(tlm::tlm_generic_payload& trans, sc
 {
     SCP_DEBUG(()) << "before bf_b_transport " << txn_command_str(trans) << " trans addr: 0x" << std::hex
                   << trans.get_address();
-    do_target_b_transport(0, trans, delay, "bf_b_transport", m_bftspt_cont, false);
+    do_target_b_transport(0, trans, delay, "bf_b_transport", false);
     SCP_DEBUG(()) << "after bf_b_transport " << txn_command_str(trans) << " trans addr: 0x" << std::hex
                   << trans.get_address();
 }
@@ -594,7 +729,7 @@ void python_binder<BUSWIDTH>::bf_b_transport(tlm::tlm_generic_payload& trans, sc
 template <unsigned int BUSWIDTH>
 unsigned int python_binder<BUSWIDTH>::transport_dbg(int id, tlm::tlm_generic_payload& trans)
 {
-    return 0;
+    return registers_b_transport(id, trans) ? trans.get_data_length() : 0;
 }
 
 template <unsigned int BUSWIDTH>
@@ -608,6 +743,15 @@ void python_binder<BUSWIDTH>::invalidate_direct_mem_ptr(sc_dt::uint64 start, sc_
 {
     SCP_DEBUG(()) << " invalidate_direct_mem_ptr start address 0x" << std::hex << start << " end address 0x" << std::hex
                   << end;
+    for (auto it = m_dmi_regions.begin(); it != m_dmi_regions.end();) {
+        std::shared_ptr<tlm_dmi_wrapper> region = it->lock();
+        if (region && (region->get_end_address() < start || region->get_start_address() > end)) {
+            ++it;
+            continue;
+        }
+        if (region) region->invalidate();
+        it = m_dmi_regions.erase(it);
+    }
     for (uint32_t i = 0; i < target_sockets.size(); i++) {
         target_sockets[i]->invalidate_direct_mem_ptr(start, end);
     }
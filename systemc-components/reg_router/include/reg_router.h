@@ -21,6 +21,7 @@
 #include <module_factory_container.h>
 #include <tlm_sockets_buswidth.h>
 #include <router_if.h>
+#include <algorithm>
 #include <vector>
 #include <memory>
 #include <map>
@@ -40,6 +41,11 @@ class reg_router : public sc_core::sc_module, public gs::router_if<BUSWIDTH>
         reg_router<BUSWIDTH>>;
     using gs::router_if<BUSWIDTH>::bound_targets;
 
+    struct decode_range {
+        std::shared_ptr<target_info> mem;
+        std::shared_ptr<target_info> cb;
+    };
+
     void register_boundto(std::string s) override
     {
         s = gs::router_if<BUSWIDTH>::nameFromSocket(s);
@@ -60,7 +66,10 @@ public:
     {
         sc_dt::uint64 addr = trans.get_address();
 
-        std::shared_ptr<target_info> ti = decode_address(trans); // Use shared_ptr
+        lazy_initialize();
+        const decode_range* range = lookup(addr);
+        target_info* ti = range ? range->mem.get() : nullptr;
+        target_info* cb = range ? range->cb.get() : nullptr;
 
         if (!ti) {
             SCP_WARN(())("Attempt to access unknown location in register memory at offset 0x{:x}", addr);
@@ -78,7 +87,8 @@ public:
         if (m_pre_b_transport_callback) m_pre_b_transport_callback(mod_found, mod_addr);
 #endif
 
-        bool found_cb = do_callbacks(trans, delay);
+        bool found_cb = cb != nullptr;
+        if (cb) call_callback(*cb, trans, delay);
         if (trans.get_response_status() >= tlm::TLM_INCOMPLETE_RESPONSE) {
             SCP_TRACEALL(()) << "call b_transport: " << txn_to_str(trans, false, found_cb);
             if (ti->use_offset) trans.set_address(addr - ti->address);
@@ -86,11 +96,8 @@ public:
             if (ti->use_offset) trans.set_address(addr);
             SCP_TRACEALL(()) << "b_transport returned: " << txn_to_str(trans, false, found_cb);
         }
-        if (trans.get_response_status() >= tlm::TLM_OK_RESPONSE) {
-            do_callbacks(trans, delay);
-        }
-        if (cb_targets.size() > 0) {
-            trans.set_dmi_allowed(false);
+        if (cb && trans.get_response_status() >= tlm::TLM_OK_RESPONSE) {
+            call_callback(*cb, trans, delay);
         }
     }
 
@@ -98,7 +105,9 @@ public:
     {
         sc_dt::uint64 addr = trans.get_address();
         // transport_dbg transactions should only be handled by register memory
-        std::shared_ptr<target_info> ti = decode_address(trans); // Use shared_ptr
+        lazy_initialize();
+        const decode_range* range = lookup(addr);
+        target_info* ti = range ? range->mem.get() : nullptr;
 
         if (!ti) {
             SCP_WARN(())("transport_dbg: Attempt to access unknown location in register memory at offset 0x{:x}", addr);
@@ -123,10 +132,74 @@ public:
         return ret;
     }
 
+    /*
+     * DMI is given to the register memory of the ranges around the address that have no register callback. Registers
+     * without callbacks and with a full mask report themselves as DMI-able, and invalidate the DMI when a callback is
+     * added or their mask narrowed.
+     */
     bool get_direct_mem_ptr(int id, tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi_data)
     {
-        SCP_TRACE(()) << "[REG-MEM] call get_direct_mem_ptr (not allowed) [txn]: " << scp::scp_txn_tostring(trans);
-        return false;
+        sc_dt::uint64 addr = trans.get_address();
+        lazy_initialize();
+        const decode_range* range = lookup(addr);
+        size_t idx = range ? range - m_ranges.data() : 0;
+        if (!range || idx + 1 >= m_ranges.size()) return false;
+        tlm::tlm_dmi::dmi_access_e access = range_dmi_access(*range, m_range_starts[idx]);
+        if (access != tlm::tlm_dmi::DMI_ACCESS_READ_WRITE) {
+            SCP_TRACE((DMI)) << "[REG-MEM] get_direct_mem_ptr not allowed [txn]: " << scp::scp_txn_tostring(trans);
+            return false;
+        }
+
+        /* extend to the neighbouring ranges of the same register memory that are DMI-able too */
+        size_t first = idx, last = idx;
+        while (first > 0 && m_ranges[first - 1].mem == range->mem &&
+               range_dmi_access(m_ranges[first - 1], m_range_starts[first - 1]) == access) {
+            first--;
+        }
+        while (last + 2 < m_ranges.size() && m_ranges[last + 1].mem == range->mem &&
+               range_dmi_access(m_ranges[last + 1], m_range_starts[last + 1]) == access) {
+            last++;
+        }
+        sc_dt::uint64 start = m_range_starts[first];
+        sc_dt::uint64 end = m_range_starts[last + 1] - 1;
+
+        target_info* ti = range->mem.get();
+        if (ti->use_offset) trans.set_address(addr - ti->address);
+        bool status = initiator_socket[ti->index]->get_direct_mem_ptr(trans, dmi_data);
+        if (ti->use_offset) trans.set_address(addr);
+        if (!status || !dmi_data.is_read_write_allowed()) return false;
+
+        if (ti->use_offset) {
+            dmi_data.set_start_address(ti->address + dmi_data.get_start_address());
+            dmi_data.set_end_address(ti->address + dmi_data.get_end_address());
+        }
+        if (dmi_data.get_start_address() < start) {
+            dmi_data.set_dmi_ptr(dmi_data.get_dmi_ptr() + (start - dmi_data.get_start_address()));
+            dmi_data.set_start_address(start);
+        }
+        if (dmi_data.get_end_address() > end) {
+            dmi_data.set_end_address(end);
+        }
+        SCP_DEBUG((DMI)) << "[REG-MEM] DMI to " << ti->name << " [0x" << std::hex << dmi_data.get_start_address()
+                         << " - 0x" << dmi_data.get_end_address() << "]";
+        return true;
+    }
+
+    /* Forward the invalidations of the register memory and of the registers, in the router address space */
+    void invalidate_direct_mem_ptr(int id, sc_dt::uint64 start, sc_dt::uint64 end)
+    {
+        std::shared_ptr<target_info> ti = bound_targets[id];
+        if (ti->use_offset) {
+            if (start >= ti->size) return;
+            end = std::min<sc_dt::uint64>(end, ti->size - 1);
+            start += ti->address;
+            end += ti->address;
+        }
+        SCP_DEBUG((DMI)) << "[REG-MEM] invalidate DMI [0x" << std::hex << start << " - 0x" << end << "] from "
+                         << ti->name;
+        for (int i = 0; i < target_socket.size(); i++) {
+            target_socket[i]->invalidate_direct_mem_ptr(start, end);
+        }
     }
 
     std::string txn_to_str(tlm::tlm_generic_payload& trans, bool is_callback = false, bool found_callback = false)
@@ -203,54 +276,122 @@ public:
 
     bool do_callbacks(tlm::tlm_generic_payload& trans, sc_core::sc_time& delay)
     {
-        if (cb_targets.empty()) {
+        lazy_initialize();
+        const decode_range* range = lookup(trans.get_address());
+        if (!range || !range->cb) {
             return false;
         }
+        call_callback(*range->cb, trans, delay);
+        return true;
+    }
 
-        sc_dt::uint64 addr = trans.get_address();
-        sc_dt::uint64 len = trans.get_data_length();
-        std::shared_ptr<target_info> ti; // Use shared_ptr
+    std::shared_ptr<target_info> decode_address(tlm::tlm_generic_payload& trans) override
+    {
+        lazy_initialize();
+        const decode_range* range = lookup(trans.get_address());
+        return range ? range->mem : nullptr;
+    }
 
-        auto search = cb_targets.equal_range(addr);
-        if (search.first != cb_targets.end() && search.first->first == addr) {
-            if ((addr - search.first->first) < search.first->second->size) {
-                ti = search.first->second;
-            }
-        } else if (search.second != cb_targets.begin()) {
-            auto expected_node = std::prev(search.second);
-            if ((addr - expected_node->first) < expected_node->second->size) {
-                ti = expected_node->second;
-            } else {
-                return false;
-            }
-        } else {
-            return false;
-        }
+private:
+    void call_callback(target_info& ti, tlm::tlm_generic_payload& trans, sc_core::sc_time& delay)
+    {
+        sc_dt::uint64 addr = trans.get_address();
         SCP_TRACEALL(()) << "call b_transport: " << txn_to_str(trans, true, true);
-        if (ti->use_offset) trans.set_address(addr - ti->address);
-        initiator_socket[ti->index]->b_transport(trans, delay);
-        if (ti->use_offset) trans.set_address(addr);
+        if (ti.use_offset) trans.set_address(addr - ti.address);
+        initiator_socket[ti.index]->b_transport(trans, delay);
+        if (ti.use_offset) trans.set_address(addr);
         SCP_TRACEALL(()) << "b_transport returned : " << txn_to_str(trans, true, true);
         if (trans.get_response_status() <= tlm::TLM_GENERIC_ERROR_RESPONSE) {
             SCP_WARN(()) << "Accesing register callback at addr: " << std::hex << addr
                          << " returned with: " << trans.get_response_string();
         }
-        return true;
     }
 
-    std::shared_ptr<target_info> decode_address(tlm::tlm_generic_payload& trans) override
+    /* Memory target (first match in binding order) and callback target (closest below) of an address, as decoded by
+     * scanning mem_targets and cb_targets. Only used to build the index. */
+    std::shared_ptr<target_info> find_mem_target(sc_dt::uint64 addr)
     {
-        lazy_initialize();
+        for (auto& ti : mem_targets) {
+            if (addr >= ti->address && (addr - ti->address) < ti->size) return ti;
+        }
+        return nullptr;
+    }
 
-        sc_dt::uint64 addr = trans.get_address();
-        sc_dt::uint64 len = trans.get_data_length();
+    std::shared_ptr<target_info> find_cb_target(sc_dt::uint64 addr)
+    {
+        auto it = cb_targets.upper_bound(addr);
+        if (it == cb_targets.begin()) return nullptr;
+        --it;
+        return ((addr - it->first) < it->second->size) ? it->second : nullptr;
+    }
 
-        for (auto ti : mem_targets) { // Iterate over shared_ptrs
-            if (addr >= ti->address && (addr - ti->address) < ti->size) {
-                return ti;
-            }
+    /*
+     * Split the address space at every target boundary: within a range, the memory and callback targets are the same.
+     * Ranges are found with a direct table indexed by (addr - base) >> 2 (or finer, if some boundaries are not word
+     * aligned) when it has at most max_direct_entries slots, and by bisection of the range starts otherwise.
+     */
+    void build_index()
+    {
+        std::vector<sc_dt::uint64> bounds;
+        auto add_bounds = [&bounds](const target_info& ti) {
+            bounds.push_back(ti.address);
+            if (ti.address + ti.size > ti.address) bounds.push_back(ti.address + ti.size);
+        };
+        for (auto& ti : mem_targets) add_bounds(*ti);
+        for (auto& cb : cb_targets) add_bounds(*cb.second);
+        std::sort(bounds.begin(), bounds.end());
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+        m_range_starts = bounds;
+        m_ranges.clear();
+        for (auto b : bounds) m_ranges.push_back({ find_mem_target(b), find_cb_target(b) });
+
+        m_direct.clear();
+        if (bounds.size() < 2) return;
+        m_direct_base = bounds.front();
+        sc_dt::uint64 granule = 0;
+        for (auto b : bounds) granule |= b - m_direct_base;
+        m_direct_shift = 0;
+        while (!(granule & (1ull << m_direct_shift)) && m_direct_shift < 2) m_direct_shift++;
+        sc_dt::uint64 slots = (bounds.back() - m_direct_base) >> m_direct_shift;
+        if (slots > p_max_direct_entries.get_value()) {
+            SCP_DEBUG(()) << "Register index: " << m_ranges.size() << " ranges, sorted";
+            return;
         }
-        return nullptr;
+        m_direct.resize(slots);
+        for (size_t i = 0; i + 1 < bounds.size(); i++) {
+            sc_dt::uint64 end = (bounds[i + 1] - m_direct_base) >> m_direct_shift;
+            for (sc_dt::uint64 s = (bounds[i] - m_direct_base) >> m_direct_shift; s < end; s++) m_direct[s] = i;
+        }
+        SCP_DEBUG(()) << "Register index: " << m_ranges.size() << " ranges, direct table of " << slots << " slots";
+    }
+
+    /* Access DMI may give to a range starting at range_start: any without a callback target, otherwise as reported by
+     * the callback target */
+    tlm::tlm_dmi::dmi_access_e range_dmi_access(const decode_range& range, sc_dt::uint64 range_start)
+    {
+        if (!range.mem) return tlm::tlm_dmi::DMI_ACCESS_NONE;
+        if (!range.cb) return tlm::tlm_dmi::DMI_ACCESS_READ_WRITE;
+        tlm::tlm_generic_payload txn;
+        tlm::tlm_dmi dmi_data;
+        txn.set_command(tlm::TLM_IGNORE_COMMAND);
+        txn.set_address(range.cb->use_offset ? range_start - range.cb->address : range_start);
+        if (!initiator_socket[range.cb->index]->get_direct_mem_ptr(txn, dmi_data)) {
+            return tlm::tlm_dmi::DMI_ACCESS_NONE;
+        }
+        return dmi_data.get_granted_access();
+    }
+
+    const decode_range* lookup(sc_dt::uint64 addr) const
+    {
+        if (!m_direct.empty()) {
+            if (addr < m_direct_base) return nullptr;
+            sc_dt::uint64 slot = (addr - m_direct_base) >> m_direct_shift;
+            return (slot < m_direct.size()) ? &m_ranges[m_direct[slot]] : nullptr;
+        }
+        auto it = std::upper_bound(m_range_starts.begin(), m_range_starts.end(), addr);
+        if (it == m_range_starts.begin()) return nullptr;
+        return &m_ranges[(it - m_range_starts.begin()) - 1];
     }
 
 protected:
@@ -297,6 +438,7 @@ protected:
                 mem_targets.push_back(ti_ptr); // Add shared_ptr
             }
         }
+        build_index();
     }
 
 public:
@@ -311,6 +453,9 @@ public:
         , target_socket("target_socket")
         , m_broker(broker)
         , lazy_init("lazy_init", false, "Initialize the reg_router lazily (eg. during simulation rather than BEOL)")
+        , p_max_direct_entries("max_direct_entries", 1 << 20,
+                               "Largest number of slots of the direct address decode table, a sorted table is used "
+                               "for larger register maps")
         , mod_addr_name_map(p_mod_addr_name_map)
         , m_pre_b_transport_callback(pre_b_transport_callback)
     {
@@ -319,7 +464,7 @@ public:
         target_socket.register_b_transport(this, &reg_router::b_transport);
         target_socket.register_transport_dbg(this, &reg_router::transport_dbg);
         target_socket.register_get_direct_mem_ptr(this, &reg_router::get_direct_mem_ptr);
-        // memory model doesn't implement invalidate_direct_mem_ptr so no need to register it
+        initiator_socket.register_invalidate_direct_mem_ptr(this, &reg_router::invalidate_direct_mem_ptr);
         SCP_DEBUG((DMI)) << "reg_router Initializing DMI SCP reporting";
     }
 
@@ -335,6 +480,7 @@ public:
     tlm_utils::multi_passthrough_target_socket<reg_router<BUSWIDTH>, BUSWIDTH> target_socket;
     cci::cci_broker_handle m_broker;
     cci::cci_param<bool> lazy_init;
+    cci::cci_param<uint64_t> p_max_direct_entries;
 
 private:
     std::vector<std::shared_ptr<target_info>> mem_targets;
@@ -342,6 +488,14 @@ private:
     std::map<uint64_t, std::pair<uint64_t, std::string>> mod_addr_name_map;
     std::function<void(bool, uint64_t)> m_pre_b_transport_callback;
     bool initialized = false;
+
+    /* m_ranges[i] starts at m_range_starts[i] and ends where the next one starts */
+    std::vector<sc_dt::uint64> m_range_starts;
+    std::vector<decode_range> m_ranges;
+    /* ((addr - m_direct_base) >> m_direct_shift) -> index in m_ranges, empty if the sorted starts are used */
+    std::vector<uint32_t> m_direct;
+    sc_dt::uint64 m_direct_base = 0;
+    unsigned int m_direct_shift = 0;
 };
 } // namespace gs
 
@@ -602,17 +602,11 @@ private:
     /// @brief Stores shared_ptrs to `target_info` objects, indexed by initiator ID.
     std::vector<std::shared_ptr<target_info>> id_targets;
 
-    /// @brief Pool of PathIDExtension objects to reuse.
-    std::vector<PathIDExtension*> m_pathIDPool;
-#if defined(THREAD_SAFE) and THREAD_SAFE
-    /// @brief Mutex for protecting the PathIDExtension pool in a thread-safe environment.
-    std::mutex m_pool_mutex;
-#endif
 
     /**
      * @brief Stamps a TLM generic payload with an initiator ID using a PathIDExtension.
      *
-     * If no PathIDExtension is present, one is taken from the pool (or created if empty)
+     * If no PathIDExtension is present, one is taken from the shared extension pool
      * and added to the transaction. The initiator ID is then pushed onto the extension's path.
      *
      * @param id The initiator ID.
@@ -623,15 +617,8 @@ private:
         PathIDExtension* ext = nullptr;
         txn.get_extension(ext);
         if (ext == nullptr) {
-#if defined(THREAD_SAFE) and THREAD_SAFE
-            std::lock_guard<std::mutex> l(m_pool_mutex);
-#endif
-            if (m_pathIDPool.size() == 0) {
-                ext = new PathIDExtension();
-            } else {
-                ext = m_pathIDPool.back();
-                m_pathIDPool.pop_back();
-            }
+            ext = PathIDExtension::acquire();
+            ext->clear();
             txn.set_extension(ext);
         }
         ext->push_back(id);
@@ -654,11 +641,8 @@ private:
         assert(ext->back() == id);
         ext->pop_back();
         if (ext->size() == 0) {
-#if defined(THREAD_SAFE) and THREAD_SAFE
-            std::lock_guard<std::mutex> l(m_pool_mutex);
-#endif
             txn.clear_extension(ext);
-            m_pathIDPool.push_back(ext);
+            ext->free();
         }
     }
 
@@ -1064,8 +1048,7 @@ public:
 
 public:
     /// @brief Destructor for the router module.
-    /// Cleans up any remaining PathIDExtension objects in the pool.
-    ~router() { m_pathIDPool.clear(); }
+    ~router() {}
 
     /**
      * @brief Adds a target to the router's address map.
@@ -29,6 +29,10 @@
 #define PL011_FLAG_TXFF 0x20
 #define PL011_FLAG_RXFE 0x10
 
+#define PL011_FIFO_DEPTH 16
+/* FIFO slots freed by the guest are given back to the backend in batches of this size, or once the FIFO is empty */
+#define PL011_RX_CREDIT_BATCH 8
+
 /* Interrupt status bits in UARTRIS, UARTMIS, UARTIMSC */
 #define INT_OE  (1 << 10)
 #define INT_BE  (1 << 9)
@@ -53,7 +57,7 @@ typedef struct PL011State {
     uint32_t dmacr;
     uint32_t int_enabled;
     uint32_t int_level;
-    uint32_t read_fifo[16];
+    uint32_t read_fifo[PL011_FIFO_DEPTH];
     uint32_t ilpr;
     uint32_t ibrd;
     uint32_t fbrd;
@@ -82,6 +86,9 @@ class Pl011 : public sc_core::sc_module
 {
     SCP_LOGGER();
 
+    /* FIFO slots read by the guest, not yet given back to the backend */
+    uint32_t m_rx_credits = 0;
+
 public:
     PL011State* s;
 
@@ -189,6 +196,11 @@ public:
         if (irqmask[0] & s->int_enabled) {
             irq->write((flags & irqmask[0]) != 0);
         }
+
+        if (m_rx_credits >= PL011_RX_CREDIT_BATCH || (m_rx_credits && s->read_count == 0)) {
+            backend_socket.can_receive_more(m_rx_credits);
+            m_rx_credits = 0;
+        }
     }
 
     uint32_t pl011_read(uint64_t offset)
@@ -201,9 +213,9 @@ public:
             s->flags &= ~PL011_FLAG_RXFF;
             c = s->read_fifo[s->read_pos];
             if (s->read_count > 0) {
-                backend_socket.can_receive_more(1);
+                m_rx_credits++;
                 s->read_count--;
-                if (++s->read_pos == 16) s->read_pos = 0;
+                if (++s->read_pos == PL011_FIFO_DEPTH) s->read_pos = 0;
             }
             if (s->read_count == 0) {
                 s->flags |= PL011_FLAG_RXFE;
@@ -276,7 +288,8 @@ public:
 
         /* fixes an issue in QBox when characters are typed before linux boots */
         s->read_count = 0;
-        backend_socket.can_receive_set(16);
+        m_rx_credits = 0;
+        backend_socket.can_receive_set(PL011_FIFO_DEPTH);
     }
 
     void pl011_write(uint64_t offset, uint32_t value)
@@ -341,28 +354,40 @@ public:
         }
     }
 
-    void pl011_put_fifo(uint32_t value)
+    /* The backend sends as many characters at once as it has credits for */
+    void pl011_receive(tlm::tlm_generic_payload& txn, sc_core::sc_time& t)
     {
+        uint8_t* data = txn.get_data_ptr();
+        int len = txn.get_streaming_width();
+        int room = PL011_FIFO_DEPTH - s->read_count;
+        uint32_t int_level = s->int_level;
         int slot;
 
+        if (len > room) {
+            SCP_WARN(()) << "RX FIFO overrun, dropping " << (len - room) << " characters";
+            s->int_level |= INT_OE;
+            len = room;
+        }
+
         slot = s->read_pos + s->read_count;
-        if (slot >= 16) slot -= 16;
-        s->read_fifo[slot] = value;
-        s->read_count++;
-        s->flags &= ~PL011_FLAG_RXFE;
-        if (!(s->lcr & 0x10) || s->read_count == 16) {
-            s->flags |= PL011_FLAG_RXFF;
+        if (slot >= PL011_FIFO_DEPTH) slot -= PL011_FIFO_DEPTH;
+        for (int i = 0; i < len; i++) {
+            s->read_fifo[slot] = data[i];
+            if (++slot == PL011_FIFO_DEPTH) slot = 0;
         }
-        if (s->read_count == s->read_trigger) {
-            s->int_level |= PL011_INT_RX;
-            pl011_update();
+
+        if (len > 0) {
+            if (s->read_count < s->read_trigger && s->read_count + len >= s->read_trigger) {
+                s->int_level |= PL011_INT_RX;
+            }
+            s->read_count += len;
+            s->flags &= ~PL011_FLAG_RXFE;
+            if (!(s->lcr & 0x10) || s->read_count == PL011_FIFO_DEPTH) {
+                s->flags |= PL011_FLAG_RXFF;
+            }
         }
-    }
-    void pl011_receive(tlm::tlm_generic_payload& txn, sc_core::sc_time& t)
-    {
-        uint8_t* data = txn.get_data_ptr();
-        for (int i = 0; i < txn.get_streaming_width(); i++) {
-            pl011_put_fifo(data[i]);
+        if (s->int_level != int_level) {
+            pl011_update();
         }
     }
 
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <systemc>
+#include <tlm>
+#include <tlm_utils/simple_target_socket.h>
+#include <cci/utils/broker.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "dma_initiator.h"
+#include <tests/test-bench.h>
+
+static constexpr uint64_t MEM_SIZE = 0x100000;
+static constexpr uint64_t PAGE_SIZE = 0x1000;
+
+/* A memory giving one DMI window per page, that can stop giving DMI and can invalidate it */
+class paged_memory : public sc_core::sc_module
+{
+public:
+    tlm_utils::simple_target_socket<paged_memory> socket;
+    std::vector<uint8_t> mem;
+    bool dmi = true;
+
+    paged_memory(const sc_core::sc_module_name& n): sc_core::sc_module(n), socket("socket"), mem(MEM_SIZE, 0)
+    {
+        socket.register_b_transport(this, &paged_memory::b_transport);
+        socket.register_get_direct_mem_ptr(this, &paged_memory::get_direct_mem_ptr);
+    }
+
+    void b_transport(tlm::tlm_generic_payload& trans, sc_core::sc_time& delay)
+    {
+        uint64_t addr = trans.get_address();
+        if (addr + trans.get_data_length() > MEM_SIZE) {
+            trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+            return;
+        }
+        if (trans.is_write()) {
+            memcpy(&mem[addr], trans.get_data_ptr(), trans.get_data_length());
+        } else {
+            memcpy(trans.get_data_ptr(), &mem[addr], trans.get_data_length());
+        }
+        trans.set_dmi_allowed(dmi);
+        trans.set_response_status(tlm::TLM_OK_RESPONSE);
+    }
+
+    bool get_direct_mem_ptr(tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi_data)
+    {
+        uint64_t page = trans.get_address() & ~(PAGE_SIZE - 1);
+        if (!dmi || page >= MEM_SIZE) return false;
+        dmi_data.set_dmi_ptr(&mem[page]);
+        dmi_data.set_start_address(page);
+        dmi_data.set_end_address(page + PAGE_SIZE - 1);
+        dmi_data.allow_read_write();
+        return true;
+    }
+
+    void invalidate(uint64_t start, uint64_t end) { socket->invalidate_direct_mem_ptr(start, end); }
+};
+
+class DmaInitiatorTestBench : public TestBench
+{
+public:
+    SCP_LOGGER();
+
+protected:
+    paged_memory m_mem;
+    gs::dma_initiator<> m_dma;
+
+    static std::vector<uint8_t> pattern(size_t len, uint8_t seed)
+    {
+        std::vector<uint8_t> v(len);
+        for (size_t i = 0; i < len; i++) v[i] = uint8_t(seed + i * 7);
+        return v;
+    }
+
+    /* Frames per second moved through a ring of descriptors: read the descriptor, read the frame, write back the
+     * descriptor */
+    double descriptor_ring(int frames)
+    {
+        static constexpr uint64_t RING = 0x40000;
+        static constexpr uint64_t BUFFERS = 0x50000;
+        static constexpr int RING_LEN = 256;
+        static constexpr uint64_t FRAME_LEN = 1514;
+        struct {
+            uint32_t ctl_stat;
+            uint32_t len;
+            uint64_t buffer;
+        } desc;
+        std::vector<uint8_t> frame(FRAME_LEN);
+
+        for (int i = 0; i < RING_LEN; i++) {
+            desc = { 0x80000000, FRAME_LEN, BUFFERS + i * 2048 };
+            m_dma.write(RING + i * sizeof(desc), reinterpret_cast<uint8_t*>(&desc), sizeof(desc));
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frames; i++) {
+            uint64_t desc_addr = RING + (i % RING_LEN) * sizeof(desc);
+            m_dma.read(desc_addr, reinterpret_cast<uint8_t*>(&desc), sizeof(desc));
+            m_dma.read(desc.buffer, frame.data(), desc.len);
+            desc.ctl_stat &= ~0x80000000;
+            m_dma.write(desc_addr, reinterpret_cast<uint8_t*>(&desc), sizeof(desc));
+            desc.ctl_stat |= 0x80000000;
+            m_dma.write(desc_addr, reinterpret_cast<uint8_t*>(&desc), sizeof(desc));
+        }
+        return frames / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+public:
+    DmaInitiatorTestBench(const sc_core::sc_module_name& n): TestBench(n), m_mem("memory"), m_dma("dma")
+    {
+        m_dma.socket.bind(m_mem.socket);
+    }
+};
+
+TEST_BENCH(DmaInitiatorTestBench, test_dma_initiator)
+{
+    SCP_DEBUG(()) << "accesses across pages fill the DMI cache one window at a time";
+    std::vector<uint8_t> data = pattern(2 * PAGE_SIZE, 1);
+    std::vector<uint8_t> read_back(data.size());
+    ASSERT_TRUE(m_dma.write(0x800, data.data(), data.size()));
+    ASSERT_EQ(m_dma.transport_count(), 1u);
+    for (uint64_t expected = 2; expected <= 3; expected++) {
+        ASSERT_TRUE(m_dma.read(0x800, read_back.data(), read_back.size()));
+        ASSERT_EQ(read_back, data);
+        ASSERT_EQ(m_dma.transport_count(), expected);
+    }
+    ASSERT_TRUE(m_dma.read(0x800, read_back.data(), read_back.size()));
+    ASSERT_EQ(m_dma.transport_count(), 3u);
+    ASSERT_EQ(read_back, data);
+
+    SCP_DEBUG(()) << "an invalidated window goes back to b_transport";
+    m_mem.invalidate(0x1000, 0x1fff);
+    ASSERT_TRUE(m_dma.read(0x800, read_back.data(), read_back.size()));
+    ASSERT_EQ(m_dma.transport_count(), 4u);
+    ASSERT_TRUE(m_dma.read(0x800, read_back.data(), read_back.size()));
+    ASSERT_EQ(m_dma.transport_count(), 4u);
+    ASSERT_EQ(read_back, data);
+
+    SCP_DEBUG(()) << "scatter/gather";
+    std::vector<gs::dma_initiator<>::sg_entry> sg = { { 0x3000, 100 }, { 0x5ff0, 0x20 }, { 0x7000, 1 } };
+    std::vector<uint8_t> sg_data = pattern(100 + 0x20 + 1, 3);
+    ASSERT_TRUE(m_dma.write(sg, sg_data.data()));
+    ASSERT_EQ(memcmp(&m_mem.mem[0x3000], &sg_data[0], 100), 0);
+    ASSERT_EQ(memcmp(&m_mem.mem[0x5ff0], &sg_data[100], 0x20), 0);
+    ASSERT_EQ(m_mem.mem[0x7000], sg_data[100 + 0x20]);
+    std::vector<uint8_t> sg_read(sg_data.size());
+    ASSERT_TRUE(m_dma.read(sg, sg_read.data()));
+    ASSERT_EQ(sg_read, sg_data);
+
+    SCP_DEBUG(()) << "asynchronous copies";
+    m_dma.p_async_min_size = PAGE_SIZE;
+    std::vector<uint8_t> page = pattern(PAGE_SIZE, 5);
+    ASSERT_TRUE(m_dma.write_async(0x10000, page.data(), page.size())); // no window yet, done synchronously
+    page = pattern(PAGE_SIZE, 6);
+    uint64_t transports = m_dma.transport_count();
+    ASSERT_TRUE(m_dma.write_async(0x10000, page.data(), page.size()));
+    m_dma.sync();
+    ASSERT_EQ(m_dma.transport_count(), transports);
+    ASSERT_EQ(memcmp(&m_mem.mem[0x10000], page.data(), PAGE_SIZE), 0);
+    std::vector<uint8_t> page_read(PAGE_SIZE);
+    ASSERT_TRUE(m_dma.read_async(0x10000, page_read.data(), page_read.size()));
+    m_dma.sync();
+    ASSERT_EQ(page_read, page);
+    m_dma.p_async_min_size = 0;
+
+    SCP_DEBUG(()) << "errors are reported";
+    ASSERT_FALSE(m_dma.read(MEM_SIZE - 4, read_back.data(), 8));
+
+    SCP_DEBUG(()) << "descriptor ring throughput";
+    static constexpr int FRAMES = 200000;
+    m_dma.p_max_dmi_windows = 256; // one window per page of the frame buffers
+    double with_dmi = descriptor_ring(FRAMES);
+    transports = m_dma.transport_count();
+    descriptor_ring(FRAMES);
+    ASSERT_EQ(m_dma.transport_count(), transports);
+
+    m_mem.dmi = false;
+    m_mem.invalidate(0, MEM_SIZE - 1);
+    double without_dmi = descriptor_ring(FRAMES);
+    std::printf("descriptor ring: %.0f frames/s with DMI, %.0f frames/s through b_transport\n", with_dmi,
+                without_dmi);
+}
+
+int sc_main(int argc, char* argv[])
+{
+    scp::LoggingGuard logging_guard(scp::LogConfig().logLevel(scp::log::WARNING));
+
+    cci_utils::consuming_broker broker("global_broker");
+    cci_register_broker(broker);
+
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef GS_REGISTER_BENCH_CHILD_H
+#define GS_REGISTER_BENCH_CHILD_H
+
+#include <cstdio>
+#include <functional>
+#include <string>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+/*
+ * SystemC can only be elaborated once per process, the benchmarks run each
+ * configuration in a child. fn elaborates and simulates it, and returns the
+ * exit status of the child.
+ */
+inline void run_child(std::function<int()> fn, const std::string& what)
+{
+    std::fflush(nullptr);
+    pid_t pid = fork();
+    if (pid == 0) {
+        int ret = fn();
+        std::fflush(nullptr);
+        _exit(ret);
+    }
+    ASSERT_GT(pid, 0) << what;
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid) << what;
+    ASSERT_TRUE(WIFEXITED(status)) << what;
+    EXPECT_EQ(WEXITSTATUS(status), 0) << what;
+}
+
+#endif // GS_REGISTER_BENCH_CHILD_H
@@ -15,6 +15,10 @@
 #define CMD0_LEN      1UL
 #define STATUS64_ADDR 0x200UL
 #define STATUS64_LEN  1UL
+#define ID_ADDR       0x300UL
+#define ID_VALUE      0x1234UL
+#define SCRATCH_ADDR  0x400UL
+#define SCRATCH_LEN   16UL
 
 RegisterTestBench::RegisterTestBench(const sc_core::sc_module_name& n)
     : TestBench(n)
@@ -26,6 +30,8 @@ RegisterTestBench::RegisterTestBench(const sc_core::sc_module_name& n)
     , CMD0_OPCODE(CMD0, CMD0.get_regname() + ".OPCODE", 27UL, 5UL)
     , CMD0_PARAM(CMD0, CMD0.get_regname() + ".PARAM", 0UL, 27UL)
     , STATUS64("STATUS64", "STATUS64", STATUS64_ADDR, STATUS64_LEN)
+    , ID("ID", "ID", ID_ADDR)
+    , SCRATCH("SCRATCH", "SCRATCH", SCRATCH_ADDR, SCRATCH_LEN)
     , last_written_value(0)
     , last_written_idx(0)
     , last_used_mask(gs::gs_full_mask<uint32_t>())
@@ -46,6 +52,14 @@ RegisterTestBench::RegisterTestBench(const sc_core::sc_module_name& n)
     STATUS64.initiator_socket.bind(m_reg_memory.socket);
     m_reg_router.initiator_socket.bind(STATUS64);
     m_reg_router.rename_last(std::string(this->name()) + ".STATUS64.target_socket");
+
+    ID.initiator_socket.bind(m_reg_memory.socket);
+    m_reg_router.initiator_socket.bind(ID);
+    m_reg_router.rename_last(std::string(this->name()) + ".ID.target_socket");
+
+    SCRATCH.initiator_socket.bind(m_reg_memory.socket);
+    m_reg_router.initiator_socket.bind(SCRATCH);
+    m_reg_router.rename_last(std::string(this->name()) + ".SCRATCH.target_socket");
 }
 
 void RegisterTestBench::end_of_elaboration()
@@ -267,6 +281,48 @@ TEST_BENCH(RegisterTestBench, test_registers)
     m_initiator.do_read<uint64_t>(STATUS64_ADDR, read_value_64);
     ASSERT_EQ(read_value_64, write_value_64); // 0x0ULL mask will be applied in pre_pread callback, so the value of the
                                               // register shouldn't change at write
+
+    SCP_DEBUG(()) << "registers with callbacks are not DMI-able";
+    ASSERT_FALSE(m_initiator.do_dmi_request(CMD0_ADDR));
+    ASSERT_FALSE(m_initiator.do_dmi_request(FIFO0_ADDR));
+
+    SCP_DEBUG(()) << "a read only register gets no DMI, its writes must go through the mask";
+    ID = ID_VALUE;
+    ID.set_mask(0x0UL);
+    ASSERT_EQ(m_initiator.do_write<uint32_t>(ID_ADDR, 0xFFFFFFFFUL), tlm::TLM_OK_RESPONSE);
+    ASSERT_FALSE(m_initiator.get_last_dmi_hint());
+    ASSERT_EQ((uint32_t)ID, ID_VALUE);
+    reg_value = 0;
+    ASSERT_EQ(m_initiator.do_read<uint32_t>(ID_ADDR, reg_value), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(reg_value, ID_VALUE);
+    ASSERT_FALSE(m_initiator.get_last_dmi_hint());
+    ASSERT_FALSE(m_initiator.do_dmi_request(ID_ADDR));
+
+    SCP_DEBUG(()) << "plain storage registers and register memory get read/write DMI";
+    ASSERT_TRUE(m_initiator.do_dmi_request(SCRATCH_ADDR));
+    const tlm::tlm_dmi& dmi = m_initiator.get_last_dmi_data();
+    ASSERT_TRUE(dmi.is_read_write_allowed());
+    ASSERT_GE(dmi.get_start_address(), ID_ADDR + sizeof(uint32_t));
+    ASSERT_LE(dmi.get_start_address(), SCRATCH_ADDR);
+    ASSERT_GE(dmi.get_end_address(), SCRATCH_ADDR + SCRATCH_LEN * sizeof(uint32_t) - 1);
+    uint32_t* scratch = reinterpret_cast<uint32_t*>(dmi.get_dmi_ptr() + (SCRATCH_ADDR - dmi.get_start_address()));
+    for (uint32_t i = 0; i < SCRATCH_LEN; i++) scratch[i] = i;
+    std::vector<uint32_t> scratch_vec(SCRATCH_LEN, 0);
+    SCRATCH.get(scratch_vec.data(), 0, SCRATCH_LEN);
+    for (uint32_t i = 0; i < SCRATCH_LEN; i++) ASSERT_EQ(scratch_vec[i], i);
+
+    SCP_DEBUG(()) << "adding a callback invalidates the DMI";
+    uint64_t inval_start = 1, inval_end = 0;
+    m_initiator.register_invalidate_direct_mem_ptr([&](uint64_t start, uint64_t end) {
+        inval_start = start;
+        inval_end = end;
+    });
+    SCRATCH.post_write([&](tlm::tlm_generic_payload& trans, sc_core::sc_time& delay) {});
+    ASSERT_LE(inval_start, SCRATCH_ADDR);
+    ASSERT_GE(inval_end, SCRATCH_ADDR + SCRATCH_LEN * sizeof(uint32_t) - 1);
+    ASSERT_FALSE(m_initiator.do_dmi_request(SCRATCH_ADDR));
+    ASSERT_EQ(m_initiator.do_write<uint32_t>(SCRATCH_ADDR, 0xABUL), tlm::TLM_OK_RESPONSE);
+    ASSERT_FALSE(m_initiator.get_last_dmi_hint());
 }
 
 int sc_main(int argc, char* argv[])
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Cost of a write to a gs_register from the model side, with and without a
+ * mask, when the register memory is reached through DMI and through
+ * b_transport.
+ */
+
+#include <systemc>
+#include <tlm>
+#include <cci/utils/broker.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "bench-child.h"
+#include "gs_memory.h"
+#include "registers.h"
+
+static constexpr int NUM_WRITES = 1000000;
+static constexpr uint64_t REG_LEN = 16;
+
+class reg_platform : public sc_core::sc_module
+{
+    gs::gs_memory<> m_reg_memory;
+
+public:
+    gs::gs_register<uint32_t> m_reg;
+
+    reg_platform(const sc_core::sc_module_name& n)
+        : sc_core::sc_module(n), m_reg_memory("reg_memory"), m_reg("REG", "REG", 0, REG_LEN)
+    {
+        m_reg.initiator_socket.bind(m_reg_memory.socket);
+    }
+};
+
+template <class FN>
+static double ns_per_write(FN fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_WRITES; i++) {
+        fn(i);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e9 / NUM_WRITES;
+}
+
+static int run(bool dmi)
+{
+    if (!dmi) {
+        cci::cci_get_broker().set_preset_cci_value("bench.reg_memory.dmi_allow", cci::cci_value(false));
+    }
+    reg_platform* p = new reg_platform("bench");
+    sc_core::sc_start(sc_core::SC_ZERO_TIME);
+    gs::gs_register<uint32_t>& reg = p->m_reg;
+    std::vector<uint32_t> values(REG_LEN, 0xAAAAAAAAUL);
+
+    reg.set(values.data(), 0, REG_LEN);
+    double full = ns_per_write([&](int i) { reg = i; });
+
+    reg.set_mask(0x00FF00FFUL);
+    double masked = ns_per_write([&](int i) { reg = i; });
+    double masked_array = ns_per_write([&](int i) {
+        values[0] = i;
+        reg.set(values.data(), 0, REG_LEN);
+    });
+
+    /* the unmasked bits of element 0 were last written with the full mask, with the same value */
+    reg.get(values.data(), 0, REG_LEN);
+    if (values[0] != uint32_t(NUM_WRITES - 1)) return 1;
+    for (uint64_t i = 1; i < REG_LEN; i++) {
+        if (values[i] != 0xAAAAAAAAUL) return 1;
+    }
+
+    std::printf("%s: full mask %.1f ns, masked %.1f ns, masked %llu elements %.1f ns per write\n",
+                dmi ? "DMI" : "b_transport", full, masked, (unsigned long long)REG_LEN, masked_array);
+    std::fflush(stdout);
+    return 0;
+}
+
+TEST(proxy_data, masked_write_benchmark)
+{
+    run_child([]() { return run(true); }, "DMI");
+    run_child([]() { return run(false); }, "b_transport");
+}
+
+int sc_main(int argc, char* argv[])
+{
+    scp::LoggingGuard logging_guard(scp::LogConfig().logLevel(scp::log::WARNING));
+
+    gs::ConfigurableBroker m_broker({
+        { "bench.reg_memory.target_socket.address", cci::cci_value(0UL) },
+        { "bench.reg_memory.target_socket.size", cci::cci_value(uint64_t(REG_LEN * sizeof(uint32_t))) },
+        { "bench.reg_memory.target_socket.relative_addresses", cci::cci_value(false) },
+    });
+
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
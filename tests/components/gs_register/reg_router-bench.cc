@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Cost of an MMIO access through a reg_router, as the number of registers
+ * grows, with the direct and the sorted address decode tables.
+ */
+
+#include <systemc>
+#include <tlm>
+#include <cci/utils/broker.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "bench-child.h"
+#include "gs_memory.h"
+#include "reg_router.h"
+#include "registers.h"
+#include <tests/initiator-tester.h>
+
+static constexpr int NUM_ACCESSES = 1000000;
+static constexpr int MAX_REGS = 10000;
+
+/* num_regs registers with a callback, every other word, the rest is plain register memory */
+class reg_platform : public sc_core::sc_module
+{
+    gs::gs_memory<> m_reg_memory;
+    std::vector<std::unique_ptr<gs::gs_register<uint32_t>>> m_regs;
+
+public:
+    gs::reg_router<> m_reg_router;
+    InitiatorTester m_initiator;
+    uint64_t callbacks = 0;
+
+    reg_platform(const sc_core::sc_module_name& n, int num_regs)
+        : sc_core::sc_module(n), m_reg_memory("reg_memory"), m_reg_router("reg_router"), m_initiator("initiator")
+    {
+        m_initiator.socket.bind(m_reg_router.target_socket);
+        m_reg_router.initiator_socket.bind(m_reg_memory.socket);
+        for (int i = 0; i < num_regs; i++) {
+            std::string rn = "REG" + std::to_string(i);
+            m_regs.push_back(std::make_unique<gs::gs_register<uint32_t>>(rn, rn, i * 2 * sizeof(uint32_t)));
+            gs::gs_register<uint32_t>& reg = *m_regs.back();
+            reg.initiator_socket.bind(m_reg_memory.socket);
+            m_reg_router.initiator_socket.bind(reg);
+            m_reg_router.rename_last(std::string(name()) + "." + rn + ".target_socket");
+            reg.post_write([this](tlm::tlm_generic_payload&, sc_core::sc_time&) { callbacks++; });
+        }
+    }
+};
+
+static int run(int num_regs, bool direct)
+{
+    if (!direct) {
+        cci::cci_get_broker().set_preset_cci_value("bench.reg_router.max_direct_entries",
+                                                   cci::cci_value(uint64_t(0)));
+    }
+    reg_platform* p = new reg_platform("bench", num_regs);
+    sc_core::sc_start(sc_core::SC_ZERO_TIME);
+
+    tlm::tlm_generic_payload txn;
+    sc_core::sc_time delay;
+    uint32_t data = 0;
+    txn.set_data_ptr(reinterpret_cast<unsigned char*>(&data));
+    txn.set_data_length(sizeof(data));
+    txn.set_streaming_width(sizeof(data));
+    txn.set_command(tlm::TLM_WRITE_COMMAND);
+
+    /* Spread the accesses over the whole map, alternating registers and plain register memory */
+    uint64_t stride = 4 * 997;
+    uint64_t span = num_regs * 2 * sizeof(uint32_t);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_ACCESSES; i++) {
+        txn.set_address((i * stride) % span);
+        txn.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+        p->m_initiator.socket->b_transport(txn, delay);
+        if (!txn.is_response_ok()) return 1;
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (p->callbacks == 0) return 1;
+
+    std::printf("%5d registers, %s table: %.0f ns/access (%llu callbacks)\n", num_regs, direct ? "direct" : "sorted",
+                elapsed * 1e9 / NUM_ACCESSES, (unsigned long long)p->callbacks);
+    std::fflush(stdout);
+    return 0;
+}
+
+TEST(reg_router, decode_benchmark)
+{
+    for (int num_regs = 100; num_regs <= MAX_REGS; num_regs *= 10) {
+        std::string what = std::to_string(num_regs) + " registers";
+        run_child([num_regs]() { return run(num_regs, true); }, what + ", direct table");
+        run_child([num_regs]() { return run(num_regs, false); }, what + ", sorted table");
+    }
+}
+
+int sc_main(int argc, char* argv[])
+{
+    scp::LoggingGuard logging_guard(scp::LogConfig().logLevel(scp::log::WARNING));
+
+    gs::ConfigurableBroker m_broker({
+        { "bench.reg_memory.target_socket.address", cci::cci_value(0UL) },
+        { "bench.reg_memory.target_socket.size", cci::cci_value(uint64_t(MAX_REGS * 2 * sizeof(uint32_t))) },
+        { "bench.reg_memory.target_socket.relative_addresses", cci::cci_value(false) },
+    });
+
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Elaboration and access cost of 10k registers, modelled as one gs_register
+ * each behind a reg_router and a reg_memory, and as gs_bank_register in a
+ * single gs_register_bank.
+ */
+
+#include <systemc>
+#include <tlm>
+#include <cci/utils/broker.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include <gtest/gtest.h>
+#include "bench-child.h"
+#include "gs_memory.h"
+#include "reg_router.h"
+#include "registers.h"
+#include "register_bank.h"
+#include <tests/initiator-tester.h>
+
+static constexpr int NUM_REGS = 10000;
+static constexpr int NUM_ACCESSES = 1000000;
+
+/* One gs_register per register, each with its sockets and parameters */
+class socket_registers : public sc_core::sc_module
+{
+    gs::gs_memory<> m_reg_memory;
+    gs::reg_router<> m_reg_router;
+    std::vector<std::unique_ptr<gs::gs_register<uint32_t>>> m_regs;
+
+public:
+    InitiatorTester m_initiator;
+    uint64_t callbacks = 0;
+
+    socket_registers(const sc_core::sc_module_name& n)
+        : sc_core::sc_module(n), m_reg_memory("reg_memory"), m_reg_router("reg_router"), m_initiator("initiator")
+    {
+        m_initiator.socket.bind(m_reg_router.target_socket);
+        m_reg_router.initiator_socket.bind(m_reg_memory.socket);
+        for (int i = 0; i < NUM_REGS; i++) {
+            std::string rn = "REG" + std::to_string(i);
+            m_regs.push_back(std::make_unique<gs::gs_register<uint32_t>>(rn, rn, i * sizeof(uint32_t)));
+            gs::gs_register<uint32_t>& reg = *m_regs.back();
+            reg.initiator_socket.bind(m_reg_memory.socket);
+            m_reg_router.initiator_socket.bind(reg);
+            m_reg_router.rename_last(std::string(name()) + "." + rn + ".target_socket");
+            if (i % 4 == 0) reg.post_write([this](tlm::tlm_generic_payload&, sc_core::sc_time&) { callbacks++; });
+        }
+    }
+
+    uint32_t value(int i) { return *m_regs[i]; }
+};
+
+/* The same registers in a register bank */
+class bank_registers : public sc_core::sc_module
+{
+    gs::gs_register_bank m_bank;
+    std::vector<std::unique_ptr<gs::gs_bank_register<uint32_t>>> m_regs;
+
+public:
+    InitiatorTester m_initiator;
+    uint64_t callbacks = 0;
+
+    bank_registers(const sc_core::sc_module_name& n)
+        : sc_core::sc_module(n), m_bank("bank", NUM_REGS * sizeof(uint32_t)), m_initiator("initiator")
+    {
+        m_initiator.socket.bind(m_bank.target_socket);
+        for (int i = 0; i < NUM_REGS; i++) {
+            std::string rn = "REG" + std::to_string(i);
+            m_regs.push_back(std::make_unique<gs::gs_bank_register<uint32_t>>(m_bank, rn, rn, i * sizeof(uint32_t)));
+            if (i % 4 == 0) {
+                m_regs.back()->post_write([this](tlm::tlm_generic_payload&, sc_core::sc_time&) { callbacks++; });
+            }
+        }
+    }
+
+    uint32_t value(int i) { return *m_regs[i]; }
+};
+
+static double since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <class PLATFORM>
+static int run(const char* what)
+{
+    auto start = std::chrono::steady_clock::now();
+    PLATFORM* p = new PLATFORM("bench");
+    sc_core::sc_start(sc_core::SC_ZERO_TIME);
+    double elaboration = since(start);
+
+    tlm::tlm_generic_payload txn;
+    sc_core::sc_time delay;
+    uint32_t data;
+    txn.set_data_ptr(reinterpret_cast<unsigned char*>(&data));
+    txn.set_data_length(sizeof(data));
+    txn.set_streaming_width(sizeof(data));
+
+    start = std::chrono::steady_clock::now();
+    txn.set_command(tlm::TLM_WRITE_COMMAND);
+    for (int i = 0; i < NUM_ACCESSES; i++) {
+        data = i;
+        txn.set_address((i % NUM_REGS) * sizeof(uint32_t));
+        txn.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+        p->m_initiator.socket->b_transport(txn, delay);
+        if (!txn.is_response_ok()) return 1;
+    }
+    double writes = since(start);
+
+    start = std::chrono::steady_clock::now();
+    txn.set_command(tlm::TLM_READ_COMMAND);
+    for (int i = 0; i < NUM_ACCESSES; i++) {
+        txn.set_address((i % NUM_REGS) * sizeof(uint32_t));
+        txn.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+        p->m_initiator.socket->b_transport(txn, delay);
+        if (!txn.is_response_ok() || data != uint32_t(NUM_ACCESSES - NUM_REGS + (i % NUM_REGS))) return 1;
+    }
+    double reads = since(start);
+
+    for (int i = 0; i < NUM_REGS; i++) {
+        if (p->value(i) != uint32_t(NUM_ACCESSES - NUM_REGS + i)) return 1;
+    }
+    if (p->callbacks != NUM_ACCESSES / 4) return 1;
+
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    std::printf("%s: %d registers, elaboration %.3fs, write %.0fns, read %.0fns per access, max RSS %ldMB\n", what,
+                NUM_REGS, elaboration, writes * 1e9 / NUM_ACCESSES, reads * 1e9 / NUM_ACCESSES, ru.ru_maxrss / 1024);
+    std::fflush(stdout);
+    return 0;
+}
+
+TEST(register_bank, benchmark)
+{
+    run_child([]() { return run<socket_registers>("gs_register + reg_router"); }, "gs_register + reg_router");
+    run_child([]() { return run<bank_registers>("gs_register_bank"); }, "gs_register_bank");
+}
+
+int sc_main(int argc, char* argv[])
+{
+    scp::LoggingGuard logging_guard(scp::LogConfig().logLevel(scp::log::WARNING));
+
+    gs::ConfigurableBroker m_broker({
+        { "bench.reg_memory.target_socket.address", cci::cci_value(0UL) },
+        { "bench.reg_memory.target_socket.size", cci::cci_value(uint64_t(NUM_REGS * sizeof(uint32_t))) },
+        { "bench.reg_memory.target_socket.relative_addresses", cci::cci_value(false) },
+    });
+
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
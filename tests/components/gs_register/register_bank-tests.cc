@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <systemc>
+#include <tlm>
+#include <cci/utils/broker.h>
+#include "register_bank.h"
+#include <tests/initiator-tester.h>
+#include <tests/test-bench.h>
+#include <vector>
+
+#define FIFO0_ADDR    0x100UL
+#define FIFO0_LEN     16UL
+#define CMD0_ADDR     0x0UL
+#define STATUS64_ADDR 0x200UL
+#define MASKED_ADDR   0x300UL
+#define BANK_SZ       0x1000UL
+
+class RegisterBankTestBench : public TestBench
+{
+public:
+    SCP_LOGGER();
+
+protected:
+    InitiatorTester m_initiator;
+    gs::gs_register_bank m_bank;
+    gs::gs_bank_register<uint32_t> FIFO0;
+    gs::gs_bank_register<uint32_t> CMD0;
+    gs::gs_field<uint32_t> CMD0_OPCODE;
+    gs::gs_field<uint32_t> CMD0_PARAM;
+    gs::gs_bank_register<uint64_t> STATUS64;
+    gs::gs_bank_register<uint32_t> MASKED;
+    int pre_read_count = 0;
+    int post_write_count = 0;
+
+public:
+    RegisterBankTestBench(const sc_core::sc_module_name& n)
+        : TestBench(n)
+        , m_initiator("initiator")
+        , m_bank("bank", BANK_SZ)
+        , FIFO0(m_bank, "FIFO0", "FIFO0", FIFO0_ADDR, FIFO0_LEN)
+        , CMD0(m_bank, "CMD0", "CMD0", CMD0_ADDR)
+        , CMD0_OPCODE(CMD0, CMD0.get_regname() + ".OPCODE", 27UL, 5UL)
+        , CMD0_PARAM(CMD0, CMD0.get_regname() + ".PARAM", 0UL, 27UL)
+        , STATUS64(m_bank, "STATUS64", "STATUS64", STATUS64_ADDR)
+        , MASKED(m_bank, "MASKED", "MASKED", MASKED_ADDR)
+    {
+        m_initiator.socket.bind(m_bank.target_socket);
+
+        CMD0.pre_read([&](tlm::tlm_generic_payload& trans, sc_core::sc_time& delay) {
+            pre_read_count++;
+            CMD0 += 1;
+        });
+        CMD0.post_read([&](tlm::tlm_generic_payload& trans, sc_core::sc_time& delay) { CMD0 *= 2; });
+        FIFO0.post_write([&](tlm::tlm_generic_payload& trans, sc_core::sc_time& delay) { post_write_count++; });
+        STATUS64.pre_write([&](tlm::tlm_generic_payload& trans, sc_core::sc_time& delay) {
+            STATUS64.set_mask(0x0ULL); /*Read Only*/
+        });
+    }
+};
+
+TEST_BENCH(RegisterBankTestBench, test_register_bank)
+{
+    ASSERT_EQ(m_bank.num_registers(), 4u);
+    ASSERT_EQ(m_bank.size(), BANK_SZ);
+
+    SCP_DEBUG(()) << "write to the register array, with and without mask";
+    ASSERT_EQ(m_initiator.do_write<uint32_t>(FIFO0_ADDR, 0xABABABABUL), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(FIFO0[0], 0xABABABABUL);
+    FIFO0.set_mask(0x00FF00FFUL);
+    ASSERT_EQ(m_initiator.do_write<uint32_t>(FIFO0_ADDR, 0xEFEFEFEFUL), tlm::TLM_OK_RESPONSE);
+    uint32_t read_value = 0;
+    FIFO0.get(&read_value, 0, 1);
+    ASSERT_EQ(read_value, 0xABEFABEFUL);
+    ASSERT_EQ(post_write_count, 2);
+
+    SCP_DEBUG(()) << "write several elements at once through the mask";
+    std::vector<uint32_t> write_vec(FIFO0_LEN, 0x12345678UL);
+    std::vector<uint32_t> read_vec(FIFO0_LEN, 0);
+    FIFO0.set_mask(0xFFFFFFFFUL);
+    FIFO0.set(std::vector<uint32_t>(FIFO0_LEN, 0xCDCDCDCDUL).data(), 0, FIFO0_LEN);
+    FIFO0.set_mask(0xFF00FF00UL);
+    ASSERT_EQ(m_initiator.do_write_with_ptr(FIFO0_ADDR, reinterpret_cast<uint8_t*>(write_vec.data()),
+                                            FIFO0_LEN * sizeof(uint32_t)),
+              tlm::TLM_OK_RESPONSE);
+    FIFO0.get(read_vec.data(), 0, FIFO0_LEN);
+    for (const auto& it : read_vec) {
+        ASSERT_EQ(it, 0x12CD56CDUL);
+    }
+    /* the data actually written is returned to the initiator */
+    ASSERT_EQ(write_vec[0], 0x12CD56CDUL);
+
+    SCP_DEBUG(()) << "test register operations and fields";
+    CMD0 = 1UL;
+    CMD0 += 1UL;
+    CMD0 *= 4;
+    CMD0 -= 1;
+    CMD0 <<= 1;
+    ASSERT_EQ((uint32_t)CMD0, 14UL);
+    CMD0 = 0xABCDEF88;
+    ASSERT_EQ((uint32_t)CMD0[CMD0_PARAM], 0x3CDEF88UL);
+    ASSERT_EQ((uint32_t)CMD0[CMD0_OPCODE], 0x15UL);
+    CMD0[CMD0_OPCODE] = 0x3;
+    ASSERT_EQ((uint32_t)CMD0, 0x1BCDEF88UL);
+
+    SCP_DEBUG(()) << "test pre/post read CBs";
+    CMD0 = 25UL;
+    read_value = 0;
+    ASSERT_EQ(m_initiator.do_read<uint32_t>(CMD0_ADDR, read_value), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(read_value, 26UL); // because of pre_read CB
+    ASSERT_EQ((uint32_t)CMD0, 52UL); // because of post_read CB
+    ASSERT_EQ(pre_read_count, 1);
+
+    SCP_DEBUG(()) << "debug accesses do not call the callbacks";
+    ASSERT_EQ(m_initiator.do_read<uint32_t>(CMD0_ADDR, read_value, true), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(read_value, 52UL);
+    ASSERT_EQ(pre_read_count, 1);
+
+    SCP_DEBUG(()) << "test 64 bit register access";
+    uint64_t write_value_64 = 0xABABABABCDCDCDCDULL;
+    STATUS64 = write_value_64;
+    uint64_t read_value_64 = 0;
+    ASSERT_EQ(m_initiator.do_read<uint64_t>(STATUS64_ADDR, read_value_64), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(read_value_64, write_value_64);
+    ASSERT_EQ(m_initiator.do_write<uint64_t>(STATUS64_ADDR, 0xFF00FF00FF00FF00ULL), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(m_initiator.do_read<uint64_t>(STATUS64_ADDR, read_value_64), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(read_value_64, write_value_64); // made read only by the pre_write callback
+
+    SCP_DEBUG(()) << "a preset mask creates the register CCI parameters";
+    ASSERT_EQ(MASKED.get_mask(), 0xFFUL);
+    ASSERT_EQ(m_initiator.do_write<uint32_t>(MASKED_ADDR, 0x12345678UL), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ((uint32_t)MASKED, 0x78UL);
+    ASSERT_EQ(gs::cci_get<uint32_t>(cci::cci_get_broker(), std::string(m_bank.name()) + ".MASKED.target_socket.mask"),
+              0xFFUL);
+
+    SCP_DEBUG(()) << "the storage between registers behaves as memory";
+    ASSERT_EQ(m_initiator.do_write<uint32_t>(0x80, 0x5A5A5A5AUL), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(m_initiator.do_read<uint32_t>(0x80, read_value), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(read_value, 0x5A5A5A5AUL);
+    ASSERT_EQ(m_initiator.do_read<uint32_t>(BANK_SZ, read_value), tlm::TLM_ADDRESS_ERROR_RESPONSE);
+
+    SCP_DEBUG(()) << "accesses crossing a register boundary are rejected";
+    MASKED = 0x11UL;
+    uint64_t write_value_cross = 0xFFFFFFFFFFFFFFFFULL;
+    /* from the storage into MASKED, which would bypass its mask */
+    ASSERT_EQ(m_initiator.do_write<uint64_t>(MASKED_ADDR - 4, write_value_cross), tlm::TLM_ADDRESS_ERROR_RESPONSE);
+    ASSERT_EQ((uint32_t)MASKED, 0x11UL);
+    /* from the last element of FIFO0 into the storage after it, which would skip the mask of the second half */
+    FIFO0.set_mask(0xFFFFFFFFUL);
+    FIFO0.set(std::vector<uint32_t>(FIFO0_LEN, 0xCDCDCDCDUL).data(), 0, FIFO0_LEN);
+    FIFO0.set_mask(0xFF00FF00UL);
+    int post_write_before = post_write_count;
+    ASSERT_EQ(m_initiator.do_write<uint64_t>(FIFO0_ADDR + (FIFO0_LEN - 1) * sizeof(uint32_t), write_value_cross),
+              tlm::TLM_ADDRESS_ERROR_RESPONSE);
+    FIFO0.get(&read_value, FIFO0_LEN - 1, 1);
+    ASSERT_EQ(read_value, 0xCDCDCDCDUL);
+    ASSERT_EQ(post_write_count, post_write_before);
+    /* from CMD0 into the storage after it, whose callbacks would only see half of the access */
+    ASSERT_EQ(m_initiator.do_read<uint64_t>(CMD0_ADDR, read_value_64), tlm::TLM_ADDRESS_ERROR_RESPONSE);
+    ASSERT_EQ(pre_read_count, 1);
+}
+
+int sc_main(int argc, char* argv[])
+{
+    scp::LoggingGuard logging_guard(scp::LogConfig()
+                                        .fileInfoFrom(sc_core::SC_ERROR)
+                                        .logAsync(false)
+                                        .logLevel(scp::log::DBGTRACE) // set log level to DBGTRACE = TRACEALL
+                                        .msgTypeFieldWidth(50));      // make the msg type column a bit tighter
+
+    gs::ConfigurableBroker m_broker({
+        { "test_register_bank.bank.MASKED.target_socket.mask", cci::cci_value(0xFFUL) },
+    });
+
+    ::testing::InitGoogleTest(&argc, argv);
+    int status = RUN_ALL_TESTS();
+    return status;
+}
@@ -23,9 +23,16 @@ test_bench = {
             addr_str="_addr", value_str=" _value",
             offset = 0x100, address = 0x2000};
         {data={0xdeadbeaf}, address = 0x0500};
+        {compressed_file=top().."/src/loader-test.bin.gz", address = 0x1800};
     }
 };
 SimpleReadData = test_bench;
 SimpleReadELFFile = test_bench;
 SimpleReadBinFile = test_bench;
 SimpleReadCSVFile = test_bench;
+SimpleReadCompressedFile = test_bench;
+
+BinFileLoad = {
+    ram = { target_socket = {address=0x0, size=0x4000000}};
+};
+CompressedFileLoad = BinFileLoad;
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <systemc>
+#include <cci_configuration>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <argparser.h>
+#include <libgsutils.h>
+
+#include "gs_memory.h"
+#include "router.h"
+#include <tests/initiator-tester.h>
+#include <tests/test-bench.h>
+
+#include <zlib.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+static constexpr uint64_t IMAGE_SIZE = 64 * 1024 * 1024;
+
+class LoaderBench : public TestBench
+{
+protected:
+    InitiatorTester m_initiator;
+    gs::router<> m_router;
+    gs::gs_memory<> m_ram;
+
+    gs::loader<> m_loader;
+
+    std::string m_image;
+
+    void make_image(bool compressed = false)
+    {
+        m_image = "/tmp/loader-bench-" + std::to_string(getpid()) + (compressed ? ".bin.gz" : ".bin");
+        std::vector<uint8_t> buf(IMAGE_SIZE);
+        for (uint64_t i = 0; i < IMAGE_SIZE; i++) buf[i] = (i * 2654435761u) >> 24;
+        if (compressed) {
+            gzFile gz = gzopen(m_image.c_str(), "wb1");
+            ASSERT_NE(gz, nullptr);
+            ASSERT_EQ(gzwrite(gz, buf.data(), buf.size()), int(buf.size()));
+            gzclose(gz);
+        } else {
+            std::ofstream out(m_image, std::ios::binary);
+            out.write(reinterpret_cast<const char*>(buf.data()), buf.size());
+        }
+    }
+
+    double time_load(bool fast)
+    {
+        m_loader.p_fast_load = fast;
+        auto start = std::chrono::steady_clock::now();
+        m_loader.file_load(m_image, 0);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void check_image()
+    {
+        for (uint64_t addr = 0; addr < IMAGE_SIZE; addr += 0x10001) {
+            uint8_t data;
+            ASSERT_EQ(m_initiator.do_read(addr, data), tlm::TLM_OK_RESPONSE);
+            ASSERT_EQ(data, uint8_t((addr * 2654435761u) >> 24)) << "at 0x" << std::hex << addr;
+        }
+    }
+
+public:
+    LoaderBench(const sc_core::sc_module_name& n)
+        : TestBench(n), m_initiator("initiator"), m_router("router"), m_ram("ram"), m_loader("load")
+    {
+        m_router.initiator_socket.bind(m_ram.socket);
+        m_router.add_initiator(m_initiator.socket);
+        m_loader.initiator_socket.bind(m_router.target_socket);
+    }
+
+    ~LoaderBench() { std::remove(m_image.c_str()); }
+};
+
+TEST_BENCH(LoaderBench, BinFileLoad)
+{
+    make_image();
+
+    double slow = time_load(false);
+    check_image();
+    double fast = time_load(true);
+    check_image();
+
+    std::cout << "loading " << (IMAGE_SIZE >> 20) << "MB" << std::endl;
+    std::cout << "debug transport: " << slow << "s" << std::endl;
+    std::cout << "mapped, DMI: " << fast << "s" << std::endl;
+    std::cout << "speedup: " << (slow / fast) << "x" << std::endl;
+}
+
+TEST_BENCH(LoaderBench, CompressedFileLoad)
+{
+    make_image(true);
+
+    auto start = std::chrono::steady_clock::now();
+    m_loader.compressed_file_load(m_image, 0);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    check_image();
+
+    std::cout << "streaming " << (IMAGE_SIZE >> 20) << "MB from gzip: " << elapsed << "s" << std::endl;
+}
+
+int sc_main(int argc, char* argv[])
+{
+    gs::ConfigurableBroker m_broker{};
+    cci::cci_originator orig{ "sc_main" };
+    auto broker_h = m_broker.create_broker_handle(orig);
+    ArgParser ap{ broker_h, argc, argv };
+
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
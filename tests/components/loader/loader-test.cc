@@ -61,6 +61,14 @@ TEST_BENCH(LoaderTest, SimpleReadBinFile)
     ASSERT_EQ(data, 0xaf);
 }
 
+TEST_BENCH(LoaderTest, SimpleReadCompressedFile)
+{
+    uint32_t data;
+    /* Target 2, from the gzip'd bin file */
+    ASSERT_EQ(m_initiator.do_read(0x1800, data), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(data, 0xdeadbeaf);
+}
+
 // Simple read into the memory and write with csv file
 TEST_BENCH(LoaderTest, SimpleReadCSVFile)
 {
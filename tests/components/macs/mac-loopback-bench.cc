@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Packets per second through the dwmac and xgmac models, with a loopback
+ * backend: every frame transmitted from the TX ring comes back in the RX
+ * ring. The rings and buffers are in a memory reached through DMI, then
+ * through b_transport only.
+ * A driver polling the status register, and one woken by the interrupt, check
+ * that a received frame is only reported once its descriptor is handed back.
+ */
+
+#include <systemc>
+#include <tlm>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <tlm_utils/simple_target_socket.h>
+#include <cci/utils/broker.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <backends/loopback.h>
+#include <dwmac.h>
+#include <xgmac.h>
+#include <tests/test-bench.h>
+
+static constexpr uint64_t MEM_SIZE = 0x100000;
+static constexpr uint64_t TX_RING = 0x0;
+static constexpr uint64_t RX_RING = 0x4000;
+static constexpr uint64_t TX_BUFFERS = 0x10000;
+static constexpr uint64_t RX_BUFFERS = 0x80000;
+static constexpr uint64_t BUFFER_SIZE = 2048;
+static constexpr int RING_LEN = 64;
+static constexpr uint32_t FRAME_LEN = 1514;
+static constexpr int ROUNDS = 1000;
+
+/* A memory giving DMI on all of it, or none at all, and counting the writes going through b_transport */
+class ring_memory : public sc_core::sc_module
+{
+public:
+    tlm_utils::simple_target_socket<ring_memory> socket;
+    std::vector<uint8_t> mem;
+    bool dmi = false;
+    uint64_t writes = 0;
+
+    ring_memory(const sc_core::sc_module_name& n): sc_core::sc_module(n), socket("socket"), mem(MEM_SIZE, 0)
+    {
+        socket.register_b_transport(this, &ring_memory::b_transport);
+        socket.register_get_direct_mem_ptr(this, &ring_memory::get_direct_mem_ptr);
+    }
+
+    void b_transport(tlm::tlm_generic_payload& trans, sc_core::sc_time& delay)
+    {
+        uint64_t addr = trans.get_address();
+        if (addr + trans.get_data_length() > MEM_SIZE) {
+            trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+            return;
+        }
+        if (trans.is_write()) {
+            memcpy(&mem[addr], trans.get_data_ptr(), trans.get_data_length());
+            writes++;
+        } else {
+            memcpy(trans.get_data_ptr(), &mem[addr], trans.get_data_length());
+        }
+        trans.set_dmi_allowed(dmi);
+        trans.set_response_status(tlm::TLM_OK_RESPONSE);
+    }
+
+    bool get_direct_mem_ptr(tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi_data)
+    {
+        if (!dmi) return false;
+        dmi_data.set_dmi_ptr(mem.data());
+        dmi_data.set_start_address(0);
+        dmi_data.set_end_address(MEM_SIZE - 1);
+        dmi_data.allow_read_write();
+        return true;
+    }
+
+    template <class T>
+    T* at(uint64_t addr)
+    {
+        return reinterpret_cast<T*>(&mem[addr]);
+    }
+};
+
+class MacLoopbackBench : public TestBench
+{
+public:
+    SCP_LOGGER();
+
+protected:
+    ring_memory m_dw_mem;
+    ring_memory m_xg_mem;
+    NetworkBackendLoopback m_dw_loop;
+    NetworkBackendLoopback m_xg_loop;
+    dwmac m_dwmac;
+    xgmac m_xgmac;
+    tlm_utils::simple_initiator_socket<MacLoopbackBench> m_dw_regs;
+    tlm_utils::simple_initiator_socket<MacLoopbackBench> m_xg_regs;
+    sc_core::sc_signal<bool> m_dw_irq[2];
+    sc_core::sc_signal<bool> m_xg_irq[3];
+
+    static void reg_write(tlm_utils::simple_initiator_socket<MacLoopbackBench>& regs, uint64_t addr, uint32_t value)
+    {
+        tlm::tlm_generic_payload trans;
+        sc_core::sc_time delay(sc_core::SC_ZERO_TIME);
+
+        trans.set_command(tlm::TLM_WRITE_COMMAND);
+        trans.set_address(addr);
+        trans.set_data_ptr(reinterpret_cast<unsigned char*>(&value));
+        trans.set_data_length(sizeof(value));
+        trans.set_streaming_width(sizeof(value));
+        regs->b_transport(trans, delay);
+        ASSERT_EQ(trans.get_response_status(), tlm::TLM_OK_RESPONSE);
+    }
+
+    static uint32_t reg_read(tlm_utils::simple_initiator_socket<MacLoopbackBench>& regs, uint64_t addr)
+    {
+        tlm::tlm_generic_payload trans;
+        sc_core::sc_time delay(sc_core::SC_ZERO_TIME);
+        uint32_t value = 0;
+
+        trans.set_command(tlm::TLM_READ_COMMAND);
+        trans.set_address(addr);
+        trans.set_data_ptr(reinterpret_cast<unsigned char*>(&value));
+        trans.set_data_length(sizeof(value));
+        trans.set_streaming_width(sizeof(value));
+        regs->b_transport(trans, delay);
+        EXPECT_EQ(trans.get_response_status(), tlm::TLM_OK_RESPONSE);
+        return value;
+    }
+
+    static void fill_tx_buffers(ring_memory& mem)
+    {
+        for (int i = 0; i < RING_LEN; i++) {
+            uint8_t* frame = &mem.mem[TX_BUFFERS + i * BUFFER_SIZE];
+            static const uint8_t header[14] = { 0x02, 0, 0, 0, 0, 0x01, 0x02, 0, 0, 0, 0, 0x02, 0x08, 0x00 };
+            memcpy(frame, header, sizeof(header));
+            for (uint32_t j = sizeof(header); j < FRAME_LEN; j++) frame[j] = uint8_t(i + j * 3);
+        }
+    }
+
+    /* Every RX buffer the MAC wrote a frame to must have its descriptor handed back */
+    template <class OWNED>
+    static void check_rx_written_back(ring_memory& mem, OWNED owned)
+    {
+        for (int i = 0; i < RING_LEN; i++) {
+            if (mem.mem[RX_BUFFERS + i * BUFFER_SIZE] != 0) {
+                ASSERT_FALSE(owned(i)) << "frame " << i << " reported before its descriptor was written back";
+            }
+        }
+    }
+
+    /* The first byte of the RX buffers tells which ones the MAC wrote a frame to */
+    static void clear_rx_buffers(ring_memory& mem)
+    {
+        for (int i = 0; i < RING_LEN; i++) mem.mem[RX_BUFFERS + i * BUFFER_SIZE] = 0;
+    }
+
+    /*
+     * Give the MAC until the last RX descriptor of the ring is handed back, polling
+     * the status register as a driver would in between
+     */
+    template <class DONE, class REPORTED, class OWNED>
+    void wait_rx(ring_memory& mem, DONE done, REPORTED reported, OWNED owned)
+    {
+        for (int i = 0; i < 16 && !done(); i++) {
+            if (reported()) check_rx_written_back(mem, owned);
+            wait(sc_core::SC_ZERO_TIME);
+        }
+        ASSERT_TRUE(done());
+    }
+
+    bool xg_rx_owned(int i)
+    {
+        return m_xg_mem.at<XGmacDesc>(RX_RING + i * sizeof(XGmacDesc))->ctl_stat & 0x80000000;
+    }
+    bool dw_rx_owned(int i) { return m_dw_mem.at<dma_desc>(RX_RING + i * 16)->des01.erx.own; }
+
+    /* One round of the "driver": fill both rings, kick TX, wait for the frames to come back */
+    void xgmac_round()
+    {
+        for (int i = 0; i < RING_LEN; i++) {
+            XGmacDesc* tx = m_xg_mem.at<XGmacDesc>(TX_RING + i * sizeof(XGmacDesc));
+            *tx = {};
+            tx->ctl_stat = 0x80000000 | 0x20000000 | (i == RING_LEN - 1 ? 0x00200000 : 0);
+            tx->buffer1_size = FRAME_LEN;
+            tx->buffer1_addr = TX_BUFFERS + i * BUFFER_SIZE;
+
+            XGmacDesc* rx = m_xg_mem.at<XGmacDesc>(RX_RING + i * sizeof(XGmacDesc));
+            *rx = {};
+            rx->ctl_stat = 0x80000000;
+            rx->buffer1_size = BUFFER_SIZE | (i == RING_LEN - 1 ? 0x8000 : 0);
+            rx->buffer1_addr = RX_BUFFERS + i * BUFFER_SIZE;
+        }
+        clear_rx_buffers(m_xg_mem);
+        reg_write(m_xg_regs, 0xf14, 0xffffffff); // DMA_STATUS
+        reg_write(m_xg_regs, 0xf04, 1);          // DMA_XMT_POLL_DEMAND
+        wait_rx(
+            m_xg_mem, [&] { return !xg_rx_owned(RING_LEN - 1); },
+            [&] { return reg_read(m_xg_regs, 0xf14) & 0x40; }, // DMA_STATUS_RI
+            [&](int i) { return xg_rx_owned(i); });
+    }
+
+    void dwmac_round()
+    {
+        for (int i = 0; i < RING_LEN; i++) {
+            dma_desc* tx = m_dw_mem.at<dma_desc>(TX_RING + i * 16);
+            memset(tx, 0, 16);
+            tx->des01.etx.own = 1;
+            tx->des01.etx.first_segment = 1;
+            tx->des01.etx.last_segment = 1;
+            tx->des01.etx.end_ring = (i == RING_LEN - 1);
+            tx->des01.etx.buffer1_size = FRAME_LEN;
+            tx->des2 = TX_BUFFERS + i * BUFFER_SIZE;
+
+            dma_desc* rx = m_dw_mem.at<dma_desc>(RX_RING + i * 16);
+            memset(rx, 0, 16);
+            rx->des01.erx.own = 1;
+            rx->des01.erx.end_ring = (i == RING_LEN - 1);
+            rx->des01.erx.buffer1_size = BUFFER_SIZE;
+            rx->des2 = RX_BUFFERS + i * BUFFER_SIZE;
+        }
+        clear_rx_buffers(m_dw_mem);
+        reg_write(m_dw_regs, 0x1014, 0x1ffff); // DMA_STATUS
+        reg_write(m_dw_regs, 0x1004, 1);       // DMA_TX_POLL
+        wait_rx(
+            m_dw_mem, [&] { return !dw_rx_owned(RING_LEN - 1); },
+            [&] { return reg_read(m_dw_regs, 0x1014) & InterruptRegister::RxInt; },
+            [&](int i) { return dw_rx_owned(i); });
+    }
+
+    /* A driver woken by the interrupt reads the descriptors right away */
+    template <class OWNED>
+    void on_irq(const sc_core::sc_event& irq, ring_memory& mem, OWNED owned)
+    {
+        sc_core::sc_spawn_options opts;
+        opts.spawn_method();
+        opts.dont_initialize();
+        opts.set_sensitivity(&irq);
+        sc_core::sc_spawn([&mem, owned] { check_rx_written_back(mem, owned); }, nullptr, &opts);
+    }
+
+    template <class ROUND, class LENGTH>
+    double packets_per_second(ring_memory& mem, ROUND round, LENGTH rx_length)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < ROUNDS; r++) {
+            round();
+            if (::testing::Test::HasFatalFailure()) return 0;
+        }
+        double pps = double(ROUNDS) * RING_LEN /
+                     std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (int i = 0; i < RING_LEN; i++) {
+            EXPECT_EQ(rx_length(i), FRAME_LEN + 4);
+            EXPECT_EQ(memcmp(&mem.mem[RX_BUFFERS + i * BUFFER_SIZE], &mem.mem[TX_BUFFERS + i * BUFFER_SIZE], FRAME_LEN),
+                      0);
+        }
+        return pps;
+    }
+
+public:
+    MacLoopbackBench(const sc_core::sc_module_name& n)
+        : TestBench(n)
+        , m_dw_mem("dw_memory")
+        , m_xg_mem("xg_memory")
+        , m_dw_loop("dw_loopback", RING_LEN)
+        , m_xg_loop("xg_loopback", RING_LEN)
+        , m_dwmac("dwmac")
+        , m_xgmac("xgmac")
+        , m_dw_regs("dw_regs")
+        , m_xg_regs("xg_regs")
+    {
+        m_dwmac.dma_inst.socket.bind(m_dw_mem.socket);
+        m_dw_regs.bind(m_dwmac.socket);
+        m_dwmac.intr0(m_dw_irq[0]);
+        m_dwmac.intr1(m_dw_irq[1]);
+        m_dwmac.set_backend(&m_dw_loop);
+
+        m_xgmac.m_dma.socket.bind(m_xg_mem.socket);
+        m_xg_regs.bind(m_xgmac.socket);
+        m_xgmac.sbd_irq(m_xg_irq[0]);
+        m_xgmac.pmt_irq(m_xg_irq[1]);
+        m_xgmac.mci_irq(m_xg_irq[2]);
+        m_xgmac.set_backend(&m_xg_loop);
+
+        fill_tx_buffers(m_dw_mem);
+        fill_tx_buffers(m_xg_mem);
+
+        on_irq(m_dw_irq[0].posedge_event(), m_dw_mem, [this](int i) { return dw_rx_owned(i); });
+        on_irq(m_xg_irq[0].posedge_event(), m_xg_mem, [this](int i) { return xg_rx_owned(i); });
+    }
+};
+
+TEST_BENCH(MacLoopbackBench, mac_loopback_bench)
+{
+    reg_write(m_xg_regs, 0xf0c, RX_RING);      // DMA_RCV_BASE_ADDR
+    reg_write(m_xg_regs, 0xf10, TX_RING);      // DMA_TX_BASE_ADDR
+    reg_write(m_xg_regs, 0xf18, 0x2 | 0x2000); // DMA_CONTROL: SR | ST
+    reg_write(m_xg_regs, 0xf1c, 0x1ffff);      // DMA_INTR_ENA
+
+    reg_write(m_dw_regs, 0x1000, 0);                    // DMA_BUS_MODE: 16 bytes descriptors
+    reg_write(m_dw_regs, 0x100c, RX_RING);              // DMA_RX_DESC_LIST_ADDR
+    reg_write(m_dw_regs, 0x1010, TX_RING);              // DMA_TX_DESC_LIST_ADDR
+    reg_write(m_dw_regs, 0x101c, 0x1ffff);              // DMA_INTERRUPTS
+    reg_write(m_dw_regs, 0x1018, (1 << 1) | (1 << 13)); // DMA_OPERATION_MODE: SR | ST
+    wait(sc_core::SC_ZERO_TIME);
+
+    auto xg_length = [&](int i) {
+        return m_xg_mem.at<XGmacDesc>(RX_RING + i * sizeof(XGmacDesc))->ctl_stat >> 16;
+    };
+    auto dw_length = [&](int i) { return m_dw_mem.at<dma_desc>(RX_RING + i * 16)->des01.erx.frame_length; };
+
+    SCP_DEBUG(()) << "one write per frame, and one per ring for the descriptor write-backs";
+    uint64_t writes = m_xg_mem.writes;
+    xgmac_round();
+    EXPECT_EQ(m_xg_mem.writes - writes, RING_LEN + 2u);
+    writes = m_dw_mem.writes;
+    dwmac_round();
+    EXPECT_EQ(m_dw_mem.writes - writes, RING_LEN + 2u);
+
+    double xg_transport = packets_per_second(m_xg_mem, [&] { xgmac_round(); }, xg_length);
+    double dw_transport = packets_per_second(m_dw_mem, [&] { dwmac_round(); }, dw_length);
+
+    m_xg_mem.dmi = true;
+    m_dw_mem.dmi = true;
+    double xg_dmi = packets_per_second(m_xg_mem, [&] { xgmac_round(); }, xg_length);
+    double dw_dmi = packets_per_second(m_dw_mem, [&] { dwmac_round(); }, dw_length);
+
+    EXPECT_EQ(m_xg_loop.dropped(), 0u);
+    EXPECT_EQ(m_dw_loop.dropped(), 0u);
+    std::printf("xgmac: %.0f packets/s with DMI, %.0f packets/s through b_transport\n", xg_dmi, xg_transport);
+    std::printf("dwmac: %.0f packets/s with DMI, %.0f packets/s through b_transport\n", dw_dmi, dw_transport);
+}
+
+int sc_main(int argc, char* argv[])
+{
+    scp::LoggingGuard logging_guard(scp::LogConfig().logLevel(scp::log::WARNING));
+
+    cci_utils::consuming_broker broker("global_broker");
+    cci_register_broker(broker);
+
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
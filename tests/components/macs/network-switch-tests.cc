@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <systemc>
+#include <cciutils.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <backends/switch.h>
+#include <tests/test-bench.h>
+
+static const char* PCAP_FILE = "network-switch-tests.pcap";
+static constexpr double SW1_PERIOD_NS = 10;
+static uint64_t sw0_forwarded = 0;
+
+static const uint8_t BROADCAST[6] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+static const uint8_t UNKNOWN[6] = { 0x02, 0, 0, 0, 0, 0x99 };
+
+/* Stands for a MAC attached to a switch port */
+struct test_nic {
+    NetworkBackend* port;
+    uint8_t mac[6];
+    std::vector<std::vector<uint8_t>> received;
+    std::vector<sc_core::sc_time> stamps;
+
+    test_nic(NetworkBackend* p, uint8_t id): port(p), mac{ 0x02, 0, 0, 0, 0, id }
+    {
+        port->register_receive(this, rx, can_rx);
+    }
+
+    static void rx(void* opaque, Payload& frame)
+    {
+        test_nic* nic = static_cast<test_nic*>(opaque);
+        nic->received.emplace_back(frame.data(), frame.data() + frame.size());
+        nic->stamps.push_back(sc_core::sc_time_stamp());
+    }
+
+    static int can_rx(void* opaque) { return 1; }
+
+    void send(const uint8_t* dst, size_t len = 60)
+    {
+        Payload frame(len);
+        frame.resize(len);
+        memcpy(frame.data(), dst, 6);
+        memcpy(frame.data() + 6, mac, 6);
+        frame.data()[12] = 0x08;
+        frame.data()[13] = 0x00;
+        for (size_t i = 14; i < len; i++) frame.data()[i] = uint8_t(i);
+        port->send(frame);
+    }
+
+    bool last_from(const test_nic& other) const
+    {
+        return !received.empty() && !memcmp(received.back().data() + 6, other.mac, 6);
+    }
+};
+
+class NetworkSwitchTestBench : public TestBench
+{
+public:
+    SCP_LOGGER();
+
+protected:
+    NetworkSwitch m_sw0;
+    NetworkSwitch m_sw1;
+    test_nic m_a, m_b, m_c;
+    test_nic m_d, m_e;
+
+    /* The frames crossing the shared memory link arrive asynchronously */
+    template <class COND>
+    void wait_for(COND cond)
+    {
+        for (int i = 0; i < 2000 && !cond(); i++) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            wait(1, sc_core::SC_NS);
+        }
+        ASSERT_TRUE(cond());
+    }
+
+    std::vector<size_t> counts() const
+    {
+        return { m_a.received.size(), m_b.received.size(), m_c.received.size(), m_d.received.size() };
+    }
+
+public:
+    NetworkSwitchTestBench(const sc_core::sc_module_name& n)
+        : TestBench(n)
+        , m_sw0("sw0")
+        , m_sw1("sw1")
+        , m_a(m_sw0.add_port(), 0xa)
+        , m_b(m_sw0.add_port(), 0xb)
+        , m_c(m_sw0.add_port(), 0xc)
+        , m_d(m_sw1.add_port(), 0xd)
+        , m_e(m_sw1.add_port(), 0xe)
+    {
+    }
+};
+
+TEST_BENCH(NetworkSwitchTestBench, network_switch)
+{
+    SCP_DEBUG(()) << "broadcast goes to every other port, and to the other simulator";
+    m_a.send(BROADCAST);
+    wait(sc_core::SC_ZERO_TIME);
+    ASSERT_EQ(m_a.received.size(), 0u);
+    ASSERT_TRUE(m_b.last_from(m_a));
+    ASSERT_TRUE(m_c.last_from(m_a));
+    wait_for([&] { return m_d.received.size() == 1; });
+    ASSERT_TRUE(m_d.last_from(m_a));
+    ASSERT_EQ(m_d.stamps.back().value() % sc_core::sc_time(SW1_PERIOD_NS, sc_core::SC_NS).value(), 0u);
+
+    SCP_DEBUG(()) << "a learned address only gets the frames sent to it";
+    m_b.send(m_a.mac);
+    wait(sc_core::SC_ZERO_TIME);
+    ASSERT_EQ(counts(), (std::vector<size_t>{ 1, 1, 1, 1 }));
+    ASSERT_TRUE(m_a.last_from(m_b));
+
+    SCP_DEBUG(()) << "an unknown address is flooded";
+    m_a.send(UNKNOWN);
+    wait(sc_core::SC_ZERO_TIME);
+    wait_for([&] { return m_d.received.size() == 2; });
+    ASSERT_EQ(counts(), (std::vector<size_t>{ 1, 2, 2, 2 }));
+
+    SCP_DEBUG(()) << "the other simulator learned a on its link, a is reached through it";
+    m_d.send(m_a.mac);
+    wait_for([&] { return m_a.received.size() == 2; });
+    ASSERT_TRUE(m_a.last_from(m_d));
+    ASSERT_EQ(counts(), (std::vector<size_t>{ 2, 2, 2, 2 }));
+
+    SCP_DEBUG(()) << "frames sent during one period are delivered together";
+    m_d.send(m_b.mac);
+    m_d.send(m_c.mac);
+    wait_for([&] { return m_b.received.size() == 3 && m_c.received.size() == 3; });
+    wait(3, sc_core::SC_NS);
+    size_t e_count = m_e.received.size();
+    sc_core::sc_time sent = sc_core::sc_time_stamp();
+    m_d.send(m_e.mac, 100);
+    m_d.send(m_e.mac, 200);
+    wait_for([&] { return m_e.received.size() == e_count + 2; });
+    ASSERT_EQ(m_e.stamps[e_count], m_e.stamps[e_count + 1]);
+    ASSERT_GT(m_e.stamps[e_count], sent);
+    ASSERT_EQ(m_e.stamps[e_count].value() % sc_core::sc_time(SW1_PERIOD_NS, sc_core::SC_NS).value(), 0u);
+    ASSERT_EQ(m_e.received[e_count + 1].size(), 200u);
+
+    ASSERT_EQ(m_sw0.dropped(), 0u);
+    ASSERT_EQ(m_sw1.dropped(), 0u);
+    sw0_forwarded = m_sw0.forwarded();
+    sc_core::sc_stop();
+}
+
+/* Runs once the simulation is over and the capture flushed */
+TEST(network_switch, pcap)
+{
+    std::FILE* f = std::fopen(PCAP_FILE, "rb");
+    ASSERT_NE(f, nullptr);
+    uint32_t header[6];
+    ASSERT_EQ(std::fread(header, sizeof(header), 1, f), 1u);
+    ASSERT_EQ(header[0], 0xa1b2c3d4u);
+    ASSERT_EQ(header[5], 1u); // ethernet
+
+    uint64_t frames = 0;
+    uint32_t record[4];
+    while (std::fread(record, sizeof(record), 1, f) == 1) {
+        ASSERT_EQ(record[2], record[3]);
+        ASSERT_EQ(std::fseek(f, record[2], SEEK_CUR), 0);
+        frames++;
+    }
+    std::fclose(f);
+    std::remove(PCAP_FILE);
+    ASSERT_GT(sw0_forwarded, 0u);
+    ASSERT_EQ(frames, sw0_forwarded);
+}
+
+/*
+ * A simulator which dies with both sides of the link attached and a frame in flight. The test bench switches must
+ * reclaim the link, and must not receive that frame.
+ */
+static bool leave_stale_link()
+{
+    pid_t pid = fork();
+    if (pid == 0) {
+        NetworkSwitch stale0("stale0");
+        NetworkSwitch stale1("stale1");
+        test_nic nic(stale0.add_port(), 0xf);
+        nic.send(BROADCAST);
+        _exit(0);
+    }
+    int status = 0;
+    return pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int sc_main(int argc, char* argv[])
+{
+    scp::LoggingGuard logging_guard(scp::LogConfig().logLevel(scp::log::WARNING));
+
+    std::string link = "/network-switch-tests-" + std::to_string(getpid());
+    gs::ConfigurableBroker m_broker({
+        { "network_switch.sw0.pcap", cci::cci_value(std::string(PCAP_FILE)) },
+        { "network_switch.sw0.shm_link", cci::cci_value(link) },
+        { "network_switch.sw1.shm_link", cci::cci_value(link) },
+        { "network_switch.sw1.delivery_period", cci::cci_value(sc_core::sc_time(SW1_PERIOD_NS, sc_core::SC_NS)) },
+        { "stale0.shm_link", cci::cci_value(link) },
+        { "stale1.shm_link", cci::cci_value(link) },
+    });
+
+    if (!leave_stale_link()) {
+        std::fprintf(stderr, "failed to leave a stale link behind\n");
+        return 1;
+    }
+
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,69 @@
+# Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""
+Register map of a python modelled peripheral, used by "python-binder-regs-tests.cc".
+CTRL, STATUS and ID are plain storage and are handled by the PythonBinder without calling into python,
+only the accesses to CMD, WAIT and GO reach b_transport().
+A write to WAIT on one target socket only completes once GO is written on another one.
+"""
+from tlm_generic_payload import tlm_response_status, tlm_generic_payload
+from sc_core import sc_time, sc_event
+import regs_register_map as register_map
+
+CTRL = 0x0
+STATUS = 0x4
+CMD = 0x8
+ID = 0xC
+WAIT = 0x10
+GO = 0x14
+
+ID_VALUE = 0x1234ABCD
+
+for target in range(0, 2):
+    register_map.add_register(target, CTRL, 4)
+    register_map.add_register(target, STATUS, 4, read_only=True)
+    register_map.add_register(target, CMD, 4, side_effects=True)
+    register_map.add_register(target, ID, 4, value=ID_VALUE, read_only=True)
+    register_map.add_register(target, WAIT, 4, side_effects=True)
+    register_map.add_register(target, GO, 4, side_effects=True)
+
+calls = 0
+go = False
+go_event = sc_event()
+running = {}
+
+
+def serve(id: int, trans: tlm_generic_payload, delay: sc_time):
+    """writing CMD sets STATUS to CTRL + the written value, reading CMD returns the number of calls"""
+    global calls, go
+    if trans.get_address() == WAIT and trans.is_write():
+        while not go:
+            yield go_event
+        trans.set_response_status(tlm_response_status.TLM_OK_RESPONSE)
+        return
+    if trans.get_address() == GO and trans.is_write():
+        go = True
+        go_event.notify()
+        trans.set_response_status(tlm_response_status.TLM_OK_RESPONSE)
+        return
+    calls += 1
+    if trans.get_address() != CMD or trans.get_data_length() != 4:
+        trans.set_response_status(tlm_response_status.TLM_ADDRESS_ERROR_RESPONSE)
+        return
+    if trans.is_write():
+        value = int.from_bytes(memoryview(trans.get_data()), "little")
+        register_map.write(id, STATUS, register_map.read(id, CTRL) + value)
+    else:
+        trans.set_data(calls.to_bytes(4, "little"))
+    trans.set_response_status(tlm_response_status.TLM_OK_RESPONSE)
+
+
+def b_transport(id: int, trans: tlm_generic_payload, delay: sc_time):
+    """a call which yields is made again until it completes, each target socket has its own call running"""
+    if id not in running:
+        running[id] = serve(id, trans, delay)
+    ret = next(running[id], None)
+    if ret is None:
+        del running[id]
+    return ret
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <systemc>
+
+#include <chrono>
+
+#include "python-binder-bench.h"
+#include <cci/utils/broker.h>
+
+/* registers declared by python-binder-regs-test.py */
+static constexpr uint64_t CTRL = 0x0;
+static constexpr uint64_t STATUS = 0x4;
+static constexpr uint64_t CMD = 0x8;
+static constexpr uint64_t ID = 0xc;
+static constexpr uint64_t WAIT = 0x10;
+static constexpr uint64_t GO = 0x14;
+
+static constexpr int PLAIN_ACCESSES = 200000;
+static constexpr int PYTHON_ACCESSES = 2000;
+
+class PythonBinderRegsTestBench : public TestBench
+{
+public:
+    SCP_LOGGER();
+    PythonBinderRegsTestBench(const sc_core::sc_module_name& n)
+        : TestBench(n), m_initiator_0("initiator_0"), m_initiator_1("initiator_1"), m_python_binder("python-binder")
+    {
+        m_initiator_0.socket.bind(m_python_binder.target_sockets[0]);
+        m_initiator_1.socket.bind(m_python_binder.target_sockets[1]);
+    }
+
+    /* reads reg n times, returns the accesses per second */
+    double bench_reads(uint64_t reg, int n)
+    {
+        uint32_t data;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; i++) {
+            EXPECT_EQ(m_initiator_0.do_read(reg, data), tlm::TLM_OK_RESPONSE);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return n / elapsed.count();
+    }
+
+protected:
+    InitiatorTester m_initiator_0;
+    InitiatorTester m_initiator_1;
+    gs::python_binder<> m_python_binder;
+};
+
+TEST_BENCH(PythonBinderRegsTestBench, regs_bench)
+{
+    uint32_t data;
+    uint16_t half;
+
+    SCP_INFO(()) << "plain registers are served without python";
+    ASSERT_EQ(m_initiator_0.do_write(CTRL, uint32_t(5)), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(m_initiator_0.do_read(CTRL, data), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(data, 5u);
+    ASSERT_EQ(m_initiator_0.do_read(ID, data), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(data, 0x1234abcdu);
+    ASSERT_EQ(m_initiator_0.do_read(ID + 2, half), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(half, 0x1234u);
+    ASSERT_EQ(m_initiator_0.do_write(ID, uint32_t(0)), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(m_initiator_0.do_read(ID, data, true), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(data, 0x1234abcdu);
+    ASSERT_EQ(m_initiator_0.do_read(CMD, data), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(data, 1u);
+
+    SCP_INFO(()) << "registers with side effects call into python";
+    ASSERT_EQ(m_initiator_0.do_write(CMD, uint32_t(10)), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(m_initiator_0.do_read(STATUS, data), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(data, 15u);
+
+    SCP_INFO(()) << "accesses pending at the same time are all served";
+    ASSERT_EQ(m_initiator_1.do_write(CTRL, uint32_t(100)), tlm::TLM_OK_RESPONSE);
+    sc_core::sc_process_handle other = sc_core::sc_spawn(
+        [&]() { EXPECT_EQ(m_initiator_1.do_write(CMD, uint32_t(20)), tlm::TLM_OK_RESPONSE); });
+    ASSERT_EQ(m_initiator_0.do_write(CMD, uint32_t(30)), tlm::TLM_OK_RESPONSE);
+    if (!other.terminated()) sc_core::wait(other.terminated_event());
+    ASSERT_EQ(m_initiator_0.do_read(STATUS, data), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(data, 35u);
+    ASSERT_EQ(m_initiator_1.do_read(STATUS, data), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(data, 120u);
+
+    double plain = bench_reads(CTRL, PLAIN_ACCESSES);
+    double python = bench_reads(CMD, PYTHON_ACCESSES);
+    ASSERT_EQ(m_initiator_0.do_read(CMD, data), tlm::TLM_OK_RESPONSE);
+    ASSERT_EQ(data, 5u + PYTHON_ACCESSES);
+    SCP_WARN(()) << "plain register: " << plain << " accesses/s, register with side effects: " << python
+                 << " accesses/s";
+
+    SCP_INFO(()) << "an access waiting in python does not hold up the other target sockets";
+    sc_core::sc_process_handle waiter = sc_core::sc_spawn(
+        [&]() { EXPECT_EQ(m_initiator_0.do_write(WAIT, uint32_t(1)), tlm::TLM_OK_RESPONSE); });
+    sc_core::wait(10, sc_core::SC_NS);
+    ASSERT_FALSE(waiter.terminated());
+    sc_core::sc_process_handle releaser = sc_core::sc_spawn(
+        [&]() { EXPECT_EQ(m_initiator_1.do_write(GO, uint32_t(1)), tlm::TLM_OK_RESPONSE); });
+    sc_core::wait(10, sc_core::SC_NS);
+    ASSERT_TRUE(releaser.terminated());
+    ASSERT_TRUE(waiter.terminated());
+}
+
+int sc_main(int argc, char* argv[])
+{
+    gs::ConfigurableBroker m_broker(
+        { { "regs_bench.python-binder.tlm_target_ports_num", cci::cci_value(2) },
+          { "regs_bench.python-binder.py_module_dir", cci::cci_value(getexepath()) },
+          { "regs_bench.python-binder.py_module_name", cci::cci_value("python-binder-regs-test") },
+          { "regs_bench.python-binder.current_mod_id_prefix", cci::cci_value("regs_") } });
+
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
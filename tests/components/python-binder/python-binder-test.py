@@ -22,6 +22,7 @@ import shlex
 import inspect
 
 signal_write_values: List[bool] = []
+test1_trans: tlm_generic_payload = None
 signal_writer_event = sc_event()
 dummy_event = sc_event()
 
@@ -117,9 +118,33 @@ def start_of_simulation() -> None:
     trans.set_command(tlm_command.TLM_WRITE_COMMAND)
     delay = sc_time(0, sc_time_unit.SC_NS)
     test_tlm_do_b_transport.do_b_transport(0, trans, delay)
+    test_dmi()
     signal_writer_event.notify(sc_time(0, sc_time_unit.SC_NS))
 
 
+def test_dmi() -> None:
+    log("test_dmi -> accessing the memory model directly")
+    trans = tlm_generic_payload()
+    trans.set_address(0x1000)
+    trans.set_read()
+    dmi = test_tlm_do_b_transport.get_direct_mem_ptr(0, trans)
+    assert dmi is not None and dmi.is_valid()
+    assert dmi.get_start_address() <= 0x1008 and dmi.get_end_address() >= 0x1800
+    mem = memoryview(dmi)
+    base = dmi.get_start_address()
+    # the data written by the b_transport above, seen without a copy
+    assert mem[0x1008 - base : 0x1010 - base] == generate_test_data3()[:8].tobytes()
+    mem[0x1800 - base : 0x1808 - base] = generate_test_data1().tobytes()
+    data = array.array("B", [0] * 8)
+    trans.set_address(0x1800)
+    trans.set_data_length(8)
+    trans.set_streaming_width(8)
+    trans.set_data_ptr(data)
+    test_tlm_do_b_transport.do_b_transport(0, trans, sc_time(0, sc_time_unit.SC_NS))
+    assert data == generate_test_data1()
+    mem.release()
+
+
 @sc_thread
 def signal_writer():
     dummy_event.notify(sc_time(10, sc_time_unit.SC_NS))
@@ -209,7 +234,9 @@ def end_of_simulation() -> None:
 
 
 def test1(id: int, trans: tlm_generic_payload, delay: sc_time):
+    global test1_trans
     log("test1 -> testing important transation attributes getting")
+    test1_trans = trans
     # systemc wait
     yield sc_time(1000, sc_time_unit.SC_NS)
     assert trans.get_data_length() == 8
@@ -233,6 +260,12 @@ def test2(id: int, trans: tlm_generic_payload, delay: sc_time):
     )
     # systemc wait
     yield sc_time(1000, sc_time_unit.SC_NS)
+    # the data of a finished transaction can't be used anymore
+    try:
+        memoryview(test1_trans.get_data())
+        assert False, "test1 transaction data still accessible"
+    except BufferError:
+        pass
     # write data to memory model
     trans.set_address(0x1000)
     trans.set_data_length(8)
@@ -251,6 +284,11 @@ def test3(id: int, trans: tlm_generic_payload, delay: sc_time):
     assert trans.get_data_length() == 16
     assert trans.get_command() == tlm_command.TLM_READ_COMMAND
     trans.set_data(data)
+    # the data is also reachable in place, without a copy
+    view = memoryview(trans.get_data())
+    assert view.tobytes() == data.tobytes()
+    view[:] = data
+    view.release()
     trans.set_response_status(tlm_response_status.TLM_OK_RESPONSE)
 
 
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file uart-pl011-rx-throughput-test.cc
+ * @brief measures the PL011 receive path through the socket backend
+ * a client thread writes a large block of data to the server socket the uart is connected to, the test
+ * reads it back from UARTDR as a polling guest would, checks it arrived complete and in order, and
+ * prints the characters received per second
+ */
+
+#include <systemc>
+
+#include "uart-pl011.h"
+
+#include <char_backend_socket.h>
+#include <tests/initiator-tester.h>
+#include <tests/test-bench.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+static constexpr unsigned short PORT = 8011;
+static constexpr size_t DATA_SIZE = 64 * 1024;
+
+/* UART registers, as word offsets */
+#define UARTDR   0
+#define UARTFR   6
+#define UARTLCR  11
+#define UARTRIS  15
+
+class TestUartThroughput : public TestBench
+{
+    Uart m_uart;
+    char_backend_socket m_server;
+    std::thread m_client;
+
+public:
+    InitiatorTester m_initiator;
+
+    TestUartThroughput(const sc_core::sc_module_name& n)
+        : TestBench(n), m_uart("uart"), m_server("s_server"), m_initiator("initiator")
+    {
+        m_uart.backend_socket.bind(m_server.m_biflow_socket);
+        m_initiator.socket.bind(m_uart.socket);
+    }
+
+    ~TestUartThroughput()
+    {
+        if (m_client.joinable()) m_client.join();
+    }
+
+    void start_client()
+    {
+        m_client = std::thread([] {
+            asio::io_context io;
+            tcp::socket socket(io);
+            tcp::endpoint endpoint(asio::ip::make_address("127.0.0.1"), PORT);
+            asio::error_code ec;
+            do {
+                socket.close();
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                socket.connect(endpoint, ec);
+            } while (ec);
+
+            std::vector<uint8_t> data(DATA_SIZE);
+            for (size_t i = 0; i < DATA_SIZE; i++) data[i] = uint8_t(i * 7);
+            asio::write(socket, asio::buffer(data), ec);
+            /* keep the connection until everything was read */
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        });
+    }
+
+    uint32_t reg_read(int reg)
+    {
+        uint32_t val;
+        EXPECT_EQ(m_initiator.do_read(reg << 2, val), tlm::TLM_OK_RESPONSE);
+        return val;
+    }
+};
+
+TEST_BENCH(TestUartThroughput, RxThroughput)
+{
+    m_initiator.do_write(UARTLCR << 2, uint32_t(0x10)); // enable the FIFO, grants the backend its credits
+    start_client();
+
+    std::chrono::steady_clock::time_point start, end;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    size_t received = 0;
+    while (received < DATA_SIZE && std::chrono::steady_clock::now() < deadline) {
+        if (reg_read(UARTFR) & PL011_FLAG_RXFE) {
+            /* let the backend send more */
+            wait(1, sc_core::SC_US);
+            std::this_thread::sleep_for(std::chrono::microseconds(10));
+            continue;
+        }
+        uint32_t c = reg_read(UARTDR);
+        if (received == 0) start = std::chrono::steady_clock::now();
+        ASSERT_EQ(c & 0xff, uint8_t(received * 7)) << "at offset " << received;
+        received++;
+    }
+    end = std::chrono::steady_clock::now();
+
+    ASSERT_EQ(received, DATA_SIZE);
+    ASSERT_EQ(reg_read(UARTRIS) & INT_OE, 0u);
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "received " << received << " characters in " << seconds << "s: " << (received / seconds)
+              << " characters/s" << std::endl;
+
+    sc_core::sc_stop();
+}
+
+int sc_main(int argc, char* argv[])
+{
+    gs::ConfigurableBroker m_broker({
+        { "RxThroughput.s_server.address", cci::cci_value("127.0.0.1:" + std::to_string(PORT)) },
+    });
+
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
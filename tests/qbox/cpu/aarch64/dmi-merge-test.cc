@@ -0,0 +1,220 @@
+/*
+ * This file is part of libqbox
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <systemc>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include <libgsutils.h>
+
+#include "test/cpu.h"
+#include "test/tester/dmi.h"
+
+#include "cortex-a53.h"
+#include "qemu-instance.h"
+
+/*
+ * ARM Cortex-A53 DMI alias merge test.
+ *
+ * The tester hands out DMI regions restricted to the 4 bytes being accessed.
+ * CPU 0 runs a sequence of phases, each writing the first N words of the DMI
+ * area once, so that N DMI regions are requested. Each region count is run
+ * with dmi_alias_merge disabled, then enabled, and all the DMI aliases are
+ * invalidated between phases. The time spent updating the memory topology
+ * (i.e. QEMU regenerating the flatview) is reported for each phase. The last
+ * phase requests more DMI regions than a CPU address space can hold aliases,
+ * which only works when the adjacent regions are fused.
+ * The other CPUs go to sleep straight away.
+ */
+class CpuArmCortexA53DmiMergeTest : public CpuArmTestBench<cpu_arm_cortexA53, CpuTesterDmi>
+{
+public:
+    static constexpr int WORD_SIZE = 4;
+    static constexpr int NUM_WORDS = CpuTesterDmi::DMI_SIZE / WORD_SIZE;
+
+    /* Read by the firmware before a phase: the number of words to write, 0 to stop */
+    static constexpr uint64_t NOT_READY = ~uint64_t(0);
+
+    static constexpr const char* FIRMWARE = R"(
+        _start:
+            ldr x2, =0x%08)" PRIx64 R"(
+            ldr x1, =0x%08)" PRIx64 R"(
+
+            mrs x0, mpidr_el1
+            and x3, x0, #0xff
+            and x0, x0, #0xff00
+            orr x0, x0, x3
+            cbnz x0, end
+
+        phase:
+            ldr x4, [x2]
+            cmn x4, #1
+            b.eq phase
+            cbz x4, end
+
+            mov x0, #0
+        loop:
+            str w0, [x1, x0, lsl #2]
+            add x0, x0, #1
+            cmp x0, x4
+            b.ne loop
+
+            str x0, [x2]
+            b phase
+
+        end:
+            wfi
+            b end
+    )";
+
+    struct Phase {
+        int regions;
+        bool merge;
+
+        uint64_t updates;
+        uint64_t merges;
+        size_t aliases;
+        std::chrono::nanoseconds update_time;
+    };
+
+protected:
+    gs::async_event m_aev;
+    int m_io_accesses = 0;
+    bool m_done = false;
+    std::vector<Phase> m_phases;
+    size_t m_cur = 0;
+    bool m_running = false;
+
+    uint64_t m_updates_start = 0;
+    uint64_t m_merges_start = 0;
+    std::chrono::nanoseconds m_time_start{ 0 };
+
+public:
+    CpuArmCortexA53DmiMergeTest(const sc_core::sc_module_name& n)
+        : CpuArmTestBench<cpu_arm_cortexA53, CpuTesterDmi>(n), m_aev("aev")
+    {
+        char buf[1024];
+        m_aev.async_attach_suspending();
+        std::snprintf(buf, sizeof(buf), FIRMWARE, CpuTesterDmi::MMIO_ADDR, CpuTesterDmi::DMI_ADDR);
+        set_firmware(buf);
+
+        /* Without merge, a CPU aborts beyond MAX_MAP aliases */
+        for (int regions : { 16, 32, 64, 128, 240 }) {
+            m_phases.push_back({ regions, false });
+            m_phases.push_back({ regions, true });
+        }
+        m_phases.push_back({ NUM_WORDS, true });
+
+        for (auto& cpu : m_cpus) {
+            cpu.p_dmi_alias_merge = true;
+        }
+    }
+
+    virtual ~CpuArmCortexA53DmiMergeTest() {}
+
+    /* CPU 0 is blocked in its MMIO access, its socket can be looked at and configured */
+    virtual uint64_t mmio_read(int id, uint64_t addr, size_t len) override
+    {
+        TEST_ASSERT(id == CpuTesterDmi::SOCKET_MMIO);
+        TEST_ASSERT(!m_running);
+
+        auto& socket = m_cpus[0].socket;
+        if (socket.get_dmi_alias_count() != 0) {
+            /* the invalidation of the previous phase is still pending on the CPU */
+            return NOT_READY;
+        }
+        if (m_cur == m_phases.size()) {
+            return 0;
+        }
+
+        const auto& stats = socket.get_dmi_alias_stats();
+        m_updates_start = stats.topology_updates;
+        m_merges_start = stats.merges;
+        m_time_start = stats.update_time;
+        socket.set_dmi_merge(m_phases[m_cur].merge);
+        m_running = true;
+        return m_phases[m_cur].regions;
+    }
+
+    virtual void mmio_write(int id, uint64_t addr, uint64_t data, size_t len) override
+    {
+        switch (id) {
+        case CpuTesterDmi::SOCKET_MMIO: {
+            TEST_ASSERT(m_running);
+            Phase& phase = m_phases[m_cur];
+            TEST_ASSERT(data == uint64_t(phase.regions));
+
+            auto& socket = m_cpus[0].socket;
+            const auto& stats = socket.get_dmi_alias_stats();
+            phase.updates = stats.topology_updates - m_updates_start;
+            phase.merges = stats.merges - m_merges_start;
+            phase.update_time = stats.update_time - m_time_start;
+            phase.aliases = socket.get_dmi_alias_count();
+            m_running = false;
+
+            if (++m_cur < m_phases.size()) {
+                m_tester.dmi_invalidate();
+            } else {
+                m_done = true;
+                m_aev.async_detach_suspending();
+                sc_core::sc_stop();
+            }
+            break;
+        }
+
+        case CpuTesterDmi::SOCKET_DMI:
+            TEST_ASSERT(len == WORD_SIZE);
+            m_io_accesses++;
+            break;
+        }
+    }
+
+    virtual bool dmi_request(int id, uint64_t addr, size_t len, tlm::tlm_dmi& ret) override
+    {
+        uint64_t start = addr & ~uint64_t(WORD_SIZE - 1);
+
+        ret.set_start_address(start);
+        ret.set_end_address(start + WORD_SIZE - 1);
+        return true;
+    }
+
+    virtual void end_of_simulation() override
+    {
+        CpuArmTestBench<cpu_arm_cortexA53, CpuTesterDmi>::end_of_simulation();
+
+        TEST_ASSERT(m_done);
+        std::cout << "regions merge aliases merges updates  us/update  ms total\n";
+        for (const Phase& p : m_phases) {
+            double total = std::chrono::duration<double, std::milli>(p.update_time).count();
+            std::printf("%7d %5s %7zu %6llu %7llu %10.1f %9.3f\n", p.regions, p.merge ? "on" : "off", p.aliases,
+                        (unsigned long long)p.merges, (unsigned long long)p.updates,
+                        p.updates ? total * 1e3 / p.updates : 0.0, total);
+        }
+        std::cout << m_io_accesses << " I/O access(es)\n";
+
+        for (size_t i = 0; i + 1 < m_phases.size(); i += 2) {
+            const Phase& off = m_phases[i];
+            const Phase& on = m_phases[i + 1];
+            TEST_ASSERT(off.merges == 0);
+            TEST_ASSERT(on.merges > 0);
+            TEST_ASSERT(on.aliases < off.aliases);
+        }
+        const Phase& last = m_phases.back();
+        TEST_ASSERT(last.aliases < NUM_WORDS / 2);
+
+        for (int i = 0; i < NUM_WORDS / 2; i++) {
+            uint64_t expected = (uint64_t(2 * i + 1) << 32) | uint64_t(2 * i);
+            TEST_ASSERT(m_tester.get_buf_value(i) == expected);
+        }
+    }
+};
+
+constexpr const char* CpuArmCortexA53DmiMergeTest::FIRMWARE;
+
+int sc_main(int argc, char* argv[]) { return run_testbench<CpuArmCortexA53DmiMergeTest>(argc, argv); }
@@ -0,0 +1,145 @@
+/*
+ *  This file is part of libqbox
+ *  Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * DMI granted by a QemuTargetSocket on a container region: only the RAM
+ * section the address falls in is granted, holes are refused, and moving the
+ * RAM invalidates the pointers handed out.
+ */
+
+#include <systemc>
+#include <tlm_utils/simple_initiator_socket.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#include <qemu-instance.h>
+#include <dmi-manager.h>
+#include <ports/target.h>
+
+#include "test/test.h"
+
+class TargetDmiTest : public TestBench
+{
+    static constexpr uint64_t CONTAINER_SIZE = 0x40000;
+    static constexpr uint64_t RAM_SIZE = 0x10000;
+    static constexpr uint64_t RAM_ADDR = 0x10000;
+    static constexpr uint64_t RAM_NEW_ADDR = 0x20000;
+
+    QemuInstanceManager m_inst_manager;
+    QemuInstance m_inst;
+    QemuTargetSocket<> m_target;
+    tlm_utils::simple_initiator_socket<TargetDmiTest> m_initiator;
+
+    QemuInstanceDmiManager::QemuContainer m_owner;
+    qemu::MemoryRegion m_container;
+    qemu::MemoryRegion m_ram_mr;
+    uint8_t* m_ram;
+
+    int m_invalidations = 0;
+
+    void invalidate_direct_mem_ptr(sc_dt::uint64 start, sc_dt::uint64 end) { m_invalidations++; }
+
+    bool get_dmi(uint64_t addr, tlm::tlm_dmi& dmi)
+    {
+        tlm::tlm_generic_payload trans;
+        trans.set_address(addr);
+        trans.set_command(tlm::TLM_READ_COMMAND);
+        dmi.init();
+        return m_initiator->get_direct_mem_ptr(trans, dmi);
+    }
+
+    uint32_t read(uint64_t addr)
+    {
+        uint32_t data = 0;
+        sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
+        tlm::tlm_generic_payload trans;
+        trans.set_address(addr);
+        trans.set_command(tlm::TLM_READ_COMMAND);
+        trans.set_data_ptr(reinterpret_cast<unsigned char*>(&data));
+        trans.set_data_length(sizeof(data));
+        trans.set_streaming_width(sizeof(data));
+        m_initiator->b_transport(trans, delay);
+        TEST_ASSERT(trans.get_response_status() == tlm::TLM_OK_RESPONSE);
+        return data;
+    }
+
+    void test()
+    {
+        tlm::tlm_dmi dmi;
+
+        SCP_INFO(SCMOD) << "only the RAM section is granted";
+        TEST_ASSERT(get_dmi(RAM_ADDR + 0x800, dmi));
+        TEST_ASSERT(dmi.get_dmi_ptr() == m_ram + 0x800);
+        TEST_ASSERT(dmi.get_start_address() == RAM_ADDR + 0x800);
+        TEST_ASSERT(dmi.get_end_address() == RAM_ADDR + RAM_SIZE - 1);
+        TEST_ASSERT(dmi.is_read_write_allowed());
+
+        SCP_INFO(SCMOD) << "holes of the container are refused";
+        TEST_ASSERT(!get_dmi(0, dmi));
+        TEST_ASSERT(!get_dmi(RAM_ADDR + RAM_SIZE, dmi));
+
+        SCP_INFO(SCMOD) << "writes through the pointer are seen by QEMU";
+        TEST_ASSERT(get_dmi(RAM_ADDR, dmi));
+        uint32_t val = 0xcafe0001;
+        std::memcpy(dmi.get_dmi_ptr() + 0x40, &val, sizeof(val));
+        TEST_ASSERT(read(RAM_ADDR + 0x40) == val);
+
+        SCP_INFO(SCMOD) << "moving the RAM invalidates the DMI";
+        int invalidations = m_invalidations;
+        qemu::LibQemu& inst = m_inst.get();
+        inst.lock_iothread();
+        m_container.del_subregion(m_ram_mr);
+        m_container.add_subregion(m_ram_mr, RAM_NEW_ADDR);
+        inst.unlock_iothread();
+        TEST_ASSERT(m_invalidations > invalidations);
+
+        TEST_ASSERT(!get_dmi(RAM_ADDR, dmi));
+        TEST_ASSERT(get_dmi(RAM_NEW_ADDR + 0x10, dmi));
+        TEST_ASSERT(dmi.get_dmi_ptr() == m_ram + 0x10);
+        TEST_ASSERT(dmi.get_start_address() == RAM_NEW_ADDR + 0x10);
+        TEST_ASSERT(dmi.get_end_address() == RAM_NEW_ADDR + RAM_SIZE - 1);
+
+        sc_core::sc_stop();
+    }
+
+public:
+    SC_HAS_PROCESS(TargetDmiTest);
+
+    TargetDmiTest(const sc_core::sc_module_name& n)
+        : TestBench(n)
+        , m_inst("inst", &m_inst_manager, qemu::Target::AARCH64)
+        , m_target("target", m_inst)
+        , m_initiator("initiator")
+        , m_ram(static_cast<uint8_t*>(std::aligned_alloc(4096, RAM_SIZE)))
+    {
+        m_initiator.register_invalidate_direct_mem_ptr(this, &TargetDmiTest::invalidate_direct_mem_ptr);
+        m_initiator.bind(m_target);
+        m_target.set_dmi_access(tlm::tlm_dmi::DMI_ACCESS_READ_WRITE);
+
+        SC_THREAD(test);
+    }
+
+    ~TargetDmiTest() { std::free(m_ram); }
+
+    void end_of_elaboration() override
+    {
+        qemu::LibQemu& inst = m_inst.get();
+
+        m_owner = inst.object_new_unparented<QemuInstanceDmiManager::QemuContainer>();
+        m_container = inst.object_new_unparented<qemu::MemoryRegion>();
+        m_ram_mr = inst.object_new_unparented<qemu::MemoryRegion>();
+
+        m_container.init(m_owner, "container", CONTAINER_SIZE);
+        m_ram_mr.init_ram_ptr(m_owner, "ram", RAM_SIZE, m_ram);
+        m_container.add_subregion(m_ram_mr, RAM_ADDR);
+
+        m_target.init_with_mr(m_container);
+    }
+};
+
+int sc_main(int argc, char* argv[]) { return run_testbench<TargetDmiTest>(argc, argv); }
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <systemc>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "qkmulti-bench.h"
+#include "qkmulti-adaptive-rate.h"
+
+/* Run an initiator syncing every quarter of a quantum, with n interactions per sync */
+static std::shared_ptr<gs::tlm_quantumkeeper_multi_adaptive_rate> run_initiator(int syncs, int interactions)
+{
+    std::atomic<bool> done{ false };
+    auto qk = std::dynamic_pointer_cast<gs::tlm_quantumkeeper_multi_adaptive_rate>(
+        gs::tlm_quantumkeeper_factory("multithread-adaptive-rate"));
+    EXPECT_NE(qk, nullptr);
+    g_qks.push_back(qk);
+
+    qk->start();
+    qk->reset();
+    std::thread t1([&]() {
+        EXPECT_EQ(qk->get_window(), 2 * quantum);
+        for (int s = 0; s < syncs; s++) {
+            for (int i = 0; i < interactions; i++) {
+                qk->record_interaction(gs::QkInteraction::MMIO);
+            }
+            qk->inc(quantum / 4);
+            qk->sync();
+            EXPECT_LE(qk->get_current_time(), sc_core::sc_time_stamp() + 8 * quantum + quantum / 4);
+        }
+        done = true;
+        qk->stop();
+    });
+    run_systemc_until(done);
+    t1.join();
+    return qk;
+}
+
+TEST(qkmulti_adaptive_rate, compute_bound_widens)
+{
+    auto qk = run_initiator(200, 0);
+    EXPECT_EQ(qk->get_window(), 8 * quantum);
+}
+
+TEST(qkmulti_adaptive_rate, io_bound_narrows)
+{
+    /* 4 syncs per quantum, 16 interactions per quantum */
+    auto qk = run_initiator(200, 4);
+    EXPECT_EQ(qk->get_window(), quantum / 2);
+}
+
+TEST(qkmulti_adaptive_rate, status)
+{
+    auto qk = run_initiator(20, 1);
+    std::string s = qk->get_status_json();
+    EXPECT_NE(s.find("\"policy\":\"adaptive-rate\""), std::string::npos);
+    EXPECT_NE(s.find("\"mmio\":20"), std::string::npos);
+    EXPECT_EQ(s.back(), '}');
+}
+
+int sc_main(int argc, char** argv)
+{
+    scp::LoggingGuard logging_guard(scp::LogConfig().logLevel(scp::log::WARNING));
+
+    auto m_broker = new gs::ConfigurableBroker();
+
+    quantum = sc_core::sc_time(1, sc_core::SC_MS);
+    tlm_utils::tlm_quantumkeeper::set_global_quantum(quantum);
+    testing::InitGoogleTest(&argc, argv);
+    int status = RUN_ALL_TESTS();
+    return status;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef QKMULTI_BENCH_H
+#define QKMULTI_BENCH_H
+
+#include <systemc>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "qk_factory.h"
+
+/* Set by sc_main, before running the tests */
+static sc_core::sc_time quantum;
+
+/*
+ * Quantum keepers own SystemC processes sensitive to their events, keep them
+ * alive until the end of the program.
+ */
+static std::vector<std::shared_ptr<gs::tlm_quantumkeeper_extended>> g_qks;
+
+inline void run_systemc_until(std::atomic<bool>& done)
+{
+    while (sc_core::sc_pending_activity() || !done) {
+        if (sc_core::sc_pending_activity()) {
+            sc_core::sc_time t = sc_core::sc_time_to_pending_activity();
+            sc_start(t);
+        }
+    }
+}
+
+/*
+ * Contention benchmark: many external threads, each with its own quantum
+ * keeper, syncing every quarter of a quantum against a single SystemC kernel.
+ * The keepers are created by make if given, by the factory for policy
+ * otherwise. Returns the number of syncs per second.
+ */
+static constexpr int NUM_THREADS = 16;
+static constexpr int NUM_SYNCS = 500;
+
+inline double run_contention(const std::string& policy,
+                             std::function<std::shared_ptr<gs::tlm_quantumkeeper_extended>()> make = nullptr)
+{
+    std::vector<std::shared_ptr<gs::tlm_quantumkeeper_extended>> qks;
+    std::vector<std::thread> threads;
+    std::atomic<int> running{ NUM_THREADS };
+    std::atomic<bool> done{ false };
+
+    for (int i = 0; i < NUM_THREADS; i++) {
+        qks.push_back(make ? make() : gs::tlm_quantumkeeper_factory(policy));
+        EXPECT_NE(qks.back(), nullptr);
+        g_qks.push_back(qks.back());
+        qks.back()->start();
+        qks.back()->reset();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_THREADS; i++) {
+        threads.emplace_back([&, i]() {
+            auto& qk = qks[i];
+            for (int s = 0; s < NUM_SYNCS; s++) {
+                /* as a vCPU does: ask for a budget, run, sync */
+                qk->time_to_sync();
+                qk->inc(quantum / 4);
+                qk->sync();
+            }
+            qk->stop();
+            if (--running == 0) {
+                done = true;
+            }
+        });
+    }
+    run_systemc_until(done);
+    for (auto& t : threads) {
+        t.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double rate = (NUM_THREADS * NUM_SYNCS) / elapsed;
+
+    std::cout << policy << ": " << NUM_THREADS << " threads, " << rate << " syncs/s" << std::endl;
+    return rate;
+}
+
+#endif // QKMULTI_BENCH_H
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <systemc>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "qkmulti-bench.h"
+#include "qkmulti-lockfree.h"
+
+using testing::AnyOf;
+using testing::Eq;
+
+TEST(qkmulti_lockfree, finished_quantum)
+{
+    std::atomic<bool> done{ false };
+    auto qk = std::make_shared<gs::tlm_quantumkeeper_multithread_lockfree>();
+    g_qks.push_back(qk);
+
+    qk->start();
+    qk->reset();
+    std::thread t1([&]() {
+        // budget should be 2*quantum
+        sc_core::sc_time budget = qk->time_to_sync();
+        EXPECT_EQ(budget, 2 * quantum);
+        sc_core::sc_time inc(100, sc_core::SC_NS);
+        qk->inc(inc);
+        budget = qk->time_to_sync();
+        EXPECT_EQ(budget, 2 * quantum - inc);
+        EXPECT_TRUE(qk->need_sync());
+        qk->sync();
+        budget = qk->time_to_sync();
+        EXPECT_THAT(budget, AnyOf(Eq(2 * quantum), Eq(2 * quantum - inc)));
+        qk->inc(budget);
+        qk->sync();
+        budget = qk->time_to_sync();
+        EXPECT_LE(budget, 2 * quantum);
+        EXPECT_GT(budget, sc_core::SC_ZERO_TIME);
+        done = true;
+        qk->stop();
+    });
+    run_systemc_until(done);
+    t1.join();
+}
+
+TEST(qkmulti_lockfree, contention)
+{
+    double locked = run_contention("multithread");
+    double lockfree = run_contention("multithread-lockfree");
+
+    std::cout << "lock-free speedup: " << (lockfree / locked) << "x" << std::endl;
+    EXPECT_GT(lockfree, 0);
+}
+
+int sc_main(int argc, char** argv)
+{
+    scp::LoggingGuard logging_guard(scp::LogConfig().logLevel(scp::log::WARNING));
+
+    auto m_broker = new gs::ConfigurableBroker();
+
+    quantum = sc_core::sc_time(1, sc_core::SC_MS);
+    tlm_utils::tlm_quantumkeeper::set_global_quantum(quantum);
+    testing::InitGoogleTest(&argc, argv);
+    int status = RUN_ALL_TESTS();
+    return status;
+}
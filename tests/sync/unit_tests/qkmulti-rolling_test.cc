@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SC_INCLUDE_DYNAMIC_PROCESSES
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+#endif
+#include <systemc>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "qkmulti-bench.h"
+#include "qkmulti-rolling.h"
+#include <semaphore.h>
+
+/* A SystemC model with a timed event every eighth of a quantum */
+class ticker : public sc_core::sc_module
+{
+public:
+    std::atomic<bool> running{ true };
+
+    SC_HAS_PROCESS(ticker);
+    ticker(const sc_core::sc_module_name& n): sc_core::sc_module(n) { SC_THREAD(tick); }
+
+    void tick()
+    {
+        while (running) {
+            sc_core::wait(quantum / 8);
+        }
+    }
+};
+
+static ticker* g_ticker;
+
+TEST(qkmulti_rolling, budget_bounded_by_next_event)
+{
+    std::atomic<bool> done{ false };
+    auto qk = gs::tlm_quantumkeeper_factory("multithread-rolling");
+    ASSERT_NE(qk, nullptr);
+    g_qks.push_back(qk);
+
+    qk->start();
+    qk->reset();
+    std::thread t1([&]() {
+        for (int s = 0; s < 100; s++) {
+            sc_core::sc_time budget = qk->time_to_sync();
+            EXPECT_LE(budget, quantum / 8);
+            qk->inc(budget == sc_core::SC_ZERO_TIME ? quantum / 16 : budget);
+            qk->sync();
+        }
+        g_ticker->running = false;
+        done = true;
+        qk->stop();
+    });
+    run_systemc_until(done);
+    t1.join();
+
+    auto rolling = std::dynamic_pointer_cast<gs::tlm_quantumkeeper_multi_rolling>(qk);
+    ASSERT_NE(rolling, nullptr);
+    EXPECT_GT(rolling->get_horizon_updates(), 0u);
+}
+
+/*
+ * The rolling keeper as it was before the horizon was published: each budget
+ * query from an external thread wakes a SystemC process up and blocks until it
+ * has computed the budget.
+ */
+class blocking_rolling : public gs::tlm_quantumkeeper_multi_quantum
+{
+    gs::async_event m_time_ev;
+    sc_core::sc_time m_next_time;
+    gs::semaphore m_sem;
+
+    sc_core::sc_time get_next_time()
+    {
+        if (status != RUNNING) return sc_core::SC_ZERO_TIME;
+
+        sc_core::sc_time quantum = tlm_utils::tlm_quantumkeeper::get_global_quantum();
+        sc_core::sc_time next_event = sc_core::sc_time_to_pending_activity();
+        sc_core::sc_time quantum_boundary = sc_core::sc_time_stamp() + quantum - get_current_time();
+        if (sc_core::sc_pending_activity_at_current_time()) {
+            m_tick.notify();
+            return sc_core::SC_ZERO_TIME;
+        } else if (sc_core::sc_pending_activity_at_future_time()) {
+            return std::min(next_event, quantum_boundary);
+        } else {
+            return quantum_boundary;
+        }
+    }
+
+    void get_time_from_systemc()
+    {
+        m_next_time = get_next_time();
+        m_sem.notify();
+    }
+
+public:
+    blocking_rolling(): m_time_ev(false)
+    {
+        sc_core::sc_spawn_options opt;
+        opt.spawn_method();
+        opt.set_sensitivity(&m_time_ev);
+        opt.dont_initialize();
+        sc_core::sc_spawn(sc_bind(&blocking_rolling::get_time_from_systemc, this), "get_time_from_sysc", &opt);
+    }
+
+    virtual sc_core::sc_time time_to_sync() override
+    {
+        if (is_sysc_thread()) return get_next_time();
+        m_time_ev.notify();
+        m_sem.wait();
+        return m_next_time;
+    }
+};
+
+TEST(qkmulti_rolling, throughput)
+{
+    double blocking_rate = run_contention("blocking rolling", []() { return std::make_shared<blocking_rolling>(); });
+    double rolling_rate = run_contention("multithread-rolling");
+
+    std::cout << "published horizon vs blocking rolling: " << (rolling_rate / blocking_rate) << "x" << std::endl;
+    EXPECT_GT(rolling_rate, 0);
+}
+
+int sc_main(int argc, char** argv)
+{
+    scp::LoggingGuard logging_guard(scp::LogConfig().logLevel(scp::log::WARNING));
+
+    auto m_broker = new gs::ConfigurableBroker();
+
+    quantum = sc_core::sc_time(1, sc_core::SC_MS);
+    tlm_utils::tlm_quantumkeeper::set_global_quantum(quantum);
+    g_ticker = new ticker("ticker");
+    testing::InitGoogleTest(&argc, argv);
+    int status = RUN_ALL_TESTS();
+    return status;
+}
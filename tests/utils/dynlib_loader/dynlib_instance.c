@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/* Large enough for the cost of copying the library to show */
+static const char payload[32 << 20] = { 1 };
+
+/* Per instance state */
+static int counter;
+
+int dynlib_instance_increment(void) { return ++counter * payload[0]; }
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <systemc>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <dynlib_loader.h>
+
+static constexpr int NUM_INSTANCES = 8;
+static std::string g_cache_dir;
+
+/*
+ * Load NUM_INSTANCES separate instances of the test library in a child process
+ * (instances cannot be unloaded), checking each has its own state. Returns the
+ * exit status of the child.
+ */
+static int load_instances(const char* mode)
+{
+    std::fflush(nullptr);
+    pid_t pid = fork();
+    if (pid == 0) {
+        setenv("GS_LIB_INSTANCE_MODE", mode, 1);
+        setenv("GS_LIB_CACHE_DIR", g_cache_dir.c_str(), 1);
+        auto& loader = qemu::get_default_lib_loader();
+        std::vector<qemu::LibraryLoaderIface::LibraryIfacePtr> libs;
+        libs.push_back(loader.load_library(DYNLIB_INSTANCE_PATH, false));
+
+        std::printf("%-8s", mode);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 1; i <= NUM_INSTANCES; i++) {
+            auto lib = loader.load_library(DYNLIB_INSTANCE_PATH, true);
+            if (!lib) {
+                std::printf("\nfailed: %s\n", loader.get_last_error());
+                _exit(1);
+            }
+            auto increment = reinterpret_cast<int (*)()>(lib->get_symbol("dynlib_instance_increment"));
+            if (increment() != 1) {
+                std::printf("\ninstance %d shares its state\n", i);
+                _exit(1);
+            }
+            libs.push_back(lib);
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::printf(" %d: %6.2fms", i, elapsed * 1e3);
+        }
+        std::printf("\n");
+        std::fflush(nullptr);
+        _exit(0);
+    }
+    int status = 0;
+    if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status)) return -1;
+    return WEXITSTATUS(status);
+}
+
+TEST(dynlib_loader, copy) { EXPECT_EQ(load_instances("copy"), 0); }
+
+TEST(dynlib_loader, memfd) { EXPECT_EQ(load_instances("memfd"), 0); }
+
+TEST(dynlib_loader, cache)
+{
+    /* copies of a library with the same name, elsewhere, are left alone */
+    std::filesystem::path other = std::filesystem::path(g_cache_dir) /
+                                  (std::filesystem::path(DYNLIB_INSTANCE_PATH).filename().string() +
+                                   "-0000000000000000-0000000000000000");
+    std::filesystem::create_directories(other);
+
+    /* the first run fills the cache, the second reuses it */
+    EXPECT_EQ(load_instances("cache"), 0);
+    EXPECT_EQ(load_instances("cache"), 0);
+    size_t builds = 0;
+    for (auto& e : std::filesystem::directory_iterator(g_cache_dir)) {
+        if (e.is_directory()) builds++;
+    }
+    EXPECT_EQ(builds, 2u);
+    EXPECT_TRUE(std::filesystem::exists(other));
+}
+
+TEST(dynlib_loader, dlmopen) { EXPECT_EQ(load_instances("dlmopen"), 0); }
+
+int sc_main(int argc, char** argv)
+{
+    char dir[] = "/tmp/qbox_dynlib_cache.XXXXXX";
+    if (!mkdtemp(dir)) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+    g_cache_dir = dir;
+
+    testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    std::filesystem::remove_all(g_cache_dir);
+    return ret;
+}
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <systemc>
+#include <tlm>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <tlm_utils/simple_target_socket.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <scp/report.h>
+#include <cciutils.h>
+#include <router.h>
+#include <tlm-extensions/extension_pool.h>
+#include <tlm-extensions/exclusive-access.h>
+
+/*
+ * Count the allocations done by the current thread, so that background
+ * threads (logging, ...) do not interfere with the measure.
+ */
+static thread_local uint64_t t_allocs = 0;
+
+void* operator new(std::size_t sz)
+{
+    t_allocs++;
+    void* p = std::malloc(sz ? sz : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+/* Stand-in for an extension set by a target on every access (e.g. QemuMrHintTlmExtension) */
+class HintExtension : public gs::pooled_tlm_extension<HintExtension>
+{
+public:
+    uint64_t offset = 0;
+
+    virtual tlm_extension_base* clone() const override { return new HintExtension(*this); }
+    virtual void copy_from(tlm_extension_base const& ext) override
+    {
+        offset = static_cast<const HintExtension&>(ext).offset;
+    }
+};
+
+static constexpr int WARMUP = 1000;
+static constexpr int ITERATIONS = 100000;
+
+TEST(extension_pool, single_thread_steady_state)
+{
+    for (int i = 0; i < WARMUP; i++) {
+        HintExtension::acquire()->free();
+    }
+
+    uint64_t pool_allocs = gs::extension_pool<HintExtension>::allocations();
+    uint64_t allocs = t_allocs;
+    for (int i = 0; i < ITERATIONS; i++) {
+        HintExtension* a = HintExtension::acquire();
+        HintExtension* b = HintExtension::acquire();
+        a->free();
+        b->free();
+    }
+    EXPECT_EQ(gs::extension_pool<HintExtension>::allocations(), pool_allocs);
+    EXPECT_EQ(t_allocs, allocs);
+}
+
+TEST(extension_pool, cross_thread_steady_state)
+{
+    /* Acquire on this thread, release on another one, as done between the SystemC and vCPU threads */
+    std::mutex m;
+    std::condition_variable cv;
+    std::deque<ExclusiveAccessTlmExtension*> q;
+    bool done = false;
+
+    std::thread releaser([&]() {
+        std::unique_lock<std::mutex> l(m);
+        for (;;) {
+            cv.wait(l, [&]() { return done || !q.empty(); });
+            while (!q.empty()) {
+                q.front()->free();
+                q.pop_front();
+            }
+            if (done) break;
+        }
+    });
+
+    auto run = [&](int n) {
+        for (int i = 0; i < n; i++) {
+            ExclusiveAccessTlmExtension* ext = ExclusiveAccessTlmExtension::acquire();
+            ext->reset();
+            ext->add_hop(i & 7);
+            {
+                std::lock_guard<std::mutex> l(m);
+                q.push_back(ext);
+            }
+            cv.notify_one();
+        }
+        /* let the releaser drain the queue before measuring */
+        for (;;) {
+            std::lock_guard<std::mutex> l(m);
+            if (q.empty()) break;
+        }
+    };
+
+    run(WARMUP);
+    uint64_t pool_allocs = gs::extension_pool<ExclusiveAccessTlmExtension>::allocations();
+    run(ITERATIONS);
+    uint64_t new_allocs = gs::extension_pool<ExclusiveAccessTlmExtension>::allocations() - pool_allocs;
+
+    {
+        std::lock_guard<std::mutex> l(m);
+        done = true;
+    }
+    cv.notify_one();
+    releaser.join();
+
+    std::cout << "cross thread: " << new_allocs << " allocation(s) for " << ITERATIONS << " transactions"
+              << std::endl;
+    /* At most the extensions in flight in the caches can be missing */
+    EXPECT_LE(new_allocs, 64u);
+}
+
+/* Only used by thread_exit, so that its depot starts empty */
+class ExitExtension : public gs::pooled_tlm_extension<ExitExtension>
+{
+public:
+    virtual tlm_extension_base* clone() const override { return new ExitExtension(*this); }
+    virtual void copy_from(tlm_extension_base const& ext) override {}
+};
+
+/* Releases its extension when the thread exits */
+struct exit_holder {
+    ExitExtension* ext = nullptr;
+    ~exit_holder()
+    {
+        if (ext) ext->free();
+    }
+};
+
+TEST(extension_pool, thread_exit)
+{
+    ExitExtension* released = nullptr;
+
+    std::thread t([&]() {
+        /* Constructed before the cache of the pool, hence destroyed after it */
+        thread_local exit_holder holder;
+        holder.ext = ExitExtension::acquire();
+        released = holder.ext;
+    });
+    t.join();
+
+    /* The extension released once the cache was gone went to the depot */
+    EXPECT_EQ(gs::extension_pool<ExitExtension>::allocations(), 1u);
+    ExitExtension* ext = ExitExtension::acquire();
+    EXPECT_EQ(ext, released);
+    EXPECT_EQ(gs::extension_pool<ExitExtension>::allocations(), 1u);
+    ext->free();
+}
+
+/* A target stamping every transaction like TlmTargetToQemuBridge does */
+class HintTarget : public sc_core::sc_module
+{
+public:
+    tlm_utils::simple_target_socket<HintTarget> socket;
+
+    HintTarget(const sc_core::sc_module_name& n): sc_core::sc_module(n), socket("target_socket")
+    {
+        socket.register_b_transport(this, &HintTarget::b_transport);
+    }
+
+    void b_transport(tlm::tlm_generic_payload& trans, sc_core::sc_time& delay)
+    {
+        HintExtension* hint = nullptr;
+        trans.get_extension(hint);
+        if (hint == nullptr) {
+            hint = HintExtension::acquire();
+            trans.set_extension(hint);
+        }
+        hint->offset = trans.get_address();
+        trans.set_response_status(tlm::TLM_OK_RESPONSE);
+    }
+};
+
+class Initiator : public sc_core::sc_module
+{
+public:
+    tlm_utils::simple_initiator_socket<Initiator> socket;
+
+    Initiator(const sc_core::sc_module_name& n): sc_core::sc_module(n), socket("initiator_socket") {}
+};
+
+static Initiator* g_initiator;
+
+TEST(extension_pool, router_steady_state)
+{
+    tlm::tlm_generic_payload trans;
+    sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
+    uint32_t data = 0;
+
+    trans.set_command(tlm::TLM_READ_COMMAND);
+    trans.set_data_ptr(reinterpret_cast<unsigned char*>(&data));
+    trans.set_data_length(sizeof(data));
+    trans.set_streaming_width(sizeof(data));
+
+    auto txn = [&](int i) {
+        trans.set_address(0x1000 + ((i * 4) & 0xff));
+        trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+        g_initiator->socket->b_transport(trans, delay);
+        ASSERT_EQ(trans.get_response_status(), tlm::TLM_OK_RESPONSE);
+        /* end of transaction: extensions go back to their pool */
+        trans.free_all_extensions();
+    };
+
+    for (int i = 0; i < WARMUP; i++) txn(i);
+
+    uint64_t allocs = t_allocs;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) txn(i);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t steady_allocs = t_allocs - allocs;
+
+    std::cout << "router: " << steady_allocs << " allocation(s) for " << ITERATIONS << " transactions, "
+              << (elapsed * 1e9 / ITERATIONS) << " ns/transaction" << std::endl;
+    EXPECT_EQ(steady_allocs, 0u);
+}
+
+int sc_main(int argc, char** argv)
+{
+    scp::LoggingGuard logging_guard(scp::LogConfig().logLevel(scp::log::WARNING));
+
+    gs::ConfigurableBroker broker;
+
+    Initiator initiator("initiator");
+    gs::router<> router("router");
+    HintTarget target("target");
+
+    router.add_target(target.socket, 0x1000, 0x1000);
+    router.add_initiator(initiator.socket);
+    g_initiator = &initiator;
+
+    sc_core::sc_start(sc_core::SC_ZERO_TIME);
+
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
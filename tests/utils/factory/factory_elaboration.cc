@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <systemc>
+#include <tlm>
+
+#include <gs_memory.h>
+#include <router.h>
+#include <libgsutils.h>
+#include <luafile_tool.h>
+#include "module_factory_container.h"
+
+/* Write a synthetic platform: a router and n memories bound to it */
+static std::string make_platform(const std::string& name, int n)
+{
+    std::string path = "/tmp/" + name + "_" + std::to_string(getpid()) + ".lua";
+    std::ofstream lua(path);
+    lua << name << " = {\n    moduletype = \"Container\";\n";
+    lua << "    router = { moduletype = \"router\"; };\n";
+    for (int i = 0; i < n; i++) {
+        lua << "    mem_" << i << " = { moduletype = \"gs_memory\"; target_socket = { address = " << i * 0x1000
+            << ", size = 0x1000, bind = \"&router.initiator_socket\" }; };\n";
+    }
+    lua << "}\n";
+    return path;
+}
+
+/* The platforms live until the end of the simulation */
+static std::vector<gs::ModuleFactory::Container*> g_platforms;
+
+TEST(factory_elaboration, scaling)
+{
+    auto broker = cci::cci_get_global_broker(cci::cci_originator("factory_elaboration"));
+
+    for (int n : { 125, 250, 500, 1000, 2000 }) {
+        std::string name = "platform_" + std::to_string(n);
+        std::string path = make_platform(name, n);
+        gs::LuaFile_Tool lua("factory_elaboration");
+        lua.config(broker, path.c_str());
+        std::remove(path.c_str());
+
+        auto start = std::chrono::steady_clock::now();
+        g_platforms.push_back(new gs::ModuleFactory::Container(name.c_str()));
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << n << " modules: " << elapsed * 1e3 << "ms, " << elapsed * 1e6 / n << "us/module" << std::endl;
+        EXPECT_NE(gs::find_sc_obj(nullptr, name + ".mem_" + std::to_string(n - 1), true), nullptr);
+    }
+
+    /* checks every socket got bound */
+    sc_core::sc_start(sc_core::SC_ZERO_TIME);
+}
+
+int sc_main(int argc, char** argv)
+{
+    scp::LoggingGuard logging_guard(scp::LogConfig().logLevel(scp::log::WARNING));
+    gs::ConfigurableBroker broker{};
+
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
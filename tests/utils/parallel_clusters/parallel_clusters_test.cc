@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <systemc>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <scp/report.h>
+#include <cciutils.h>
+#include <module_factory_container.h>
+#include <parallel_clusters.h>
+
+static constexpr int NUM_CLUSTERS = 4;
+/* Each cluster sends a byte to the next one every SEND_EVERY timer ticks */
+static constexpr uint64_t SEND_EVERY = 4;
+static constexpr uint64_t TIMER_PERIOD_NS = 100;
+static constexpr uint64_t SIM_TIME_NS = 1000 * 1000;
+static constexpr uint64_t QUANTUM_NS = 10 * 1000;
+static constexpr uint64_t LINK_LATENCY_NS = 20 * 1000;
+
+/* Set in each simulation process by configure() */
+static sc_core::sc_time TIMER_PERIOD;
+static sc_core::sc_time SIM_TIME;
+static sc_core::sc_time LINK_LATENCY;
+
+/* What a cluster saw before SIM_TIME, written to memory shared with the test process */
+struct cluster_result {
+    uint64_t ticks;
+    uint64_t bytes;
+    uint64_t received;
+    uint64_t misplaced; // received at another time than sent + LINK_LATENCY
+    uint64_t checksum;  // of the messages received, whatever their order within a time step
+    uint64_t late;
+};
+static cluster_result* g_results;
+
+/* Some host work per simulated event, so that the clusters are compute bound */
+static uint32_t crc32(const uint8_t* buf, size_t len, uint32_t crc)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= buf[i];
+        for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+static uint64_t mix(uint64_t v)
+{
+    v ^= v >> 33;
+    v *= 0xff51afd7ed558ccdULL;
+    v ^= v >> 33;
+    return v;
+}
+
+/*
+ * A timer firing periodically, and a UART draining the bytes it produces.
+ * Every SEND_EVERY ticks, one byte is also sent to the next cluster.
+ */
+class test_cluster : public sc_core::sc_module
+{
+    sc_core::sc_event m_timer_ev;
+    sc_core::sc_fifo<uint8_t> m_tx;
+    uint8_t m_buf[64] = {};
+    uint32_t m_crc = 0;
+
+public:
+    cci::cci_param<int> p_cluster;
+    cluster_result result = {};
+    std::function<void(int to, uint64_t data)> send;
+
+    SC_HAS_PROCESS(test_cluster);
+    test_cluster(const sc_core::sc_module_name& n)
+        : sc_core::sc_module(n), m_tx("tx", 16), p_cluster("cluster", 0, "index of this cluster")
+    {
+        SC_METHOD(timer);
+        sensitive << m_timer_ev;
+        SC_THREAD(uart);
+    }
+
+    int index() const { return p_cluster; }
+
+    void timer()
+    {
+        if (sc_core::sc_time_stamp() >= SIM_TIME) return;
+        uint64_t tick = result.ticks++;
+        m_crc = crc32(m_buf, sizeof(m_buf), m_crc);
+        m_buf[tick % sizeof(m_buf)] = m_crc;
+        m_tx.nb_write(m_crc & 0xff);
+        if (tick % SEND_EVERY == 0) {
+            send((index() + 1) % NUM_CLUSTERS, (tick << 8) | (m_crc & 0xff));
+        }
+        m_timer_ev.notify(TIMER_PERIOD);
+    }
+
+    void uart()
+    {
+        for (;;) {
+            uint8_t c = m_tx.read();
+            if (sc_core::sc_time_stamp() >= SIM_TIME) continue;
+            m_crc = crc32(&c, 1, m_crc);
+            result.bytes++;
+            sc_core::wait(TIMER_PERIOD / 10);
+        }
+    }
+
+    void receive(int from, uint64_t data)
+    {
+        sc_core::sc_time now = sc_core::sc_time_stamp();
+        if (now >= SIM_TIME) return;
+        result.received++;
+        if (from != (index() + NUM_CLUSTERS - 1) % NUM_CLUSTERS ||
+            now != TIMER_PERIOD * double(data >> 8) + LINK_LATENCY) {
+            result.misplaced++;
+        }
+        result.checksum += mix(now.value() ^ mix(data + from));
+    }
+};
+GSC_MODULE_REGISTER(test_cluster);
+
+static test_cluster* find_cluster(int i)
+{
+    return dynamic_cast<test_cluster*>(gs::find_sc_obj(nullptr, "platform.cluster_" + std::to_string(i), true));
+}
+
+/* Configure the clusters from first to last in the platform container */
+static void configure(int first, int last)
+{
+    auto broker_h = cci::cci_get_global_broker(cci::cci_originator("sc_main"));
+    for (int i = first; i <= last; i++) {
+        std::string name = "platform.cluster_" + std::to_string(i);
+        broker_h.set_preset_cci_value(name + ".moduletype", cci::cci_value("test_cluster"));
+        broker_h.set_preset_cci_value(name + ".cluster", cci::cci_value(i));
+    }
+
+    TIMER_PERIOD = sc_core::sc_time(double(TIMER_PERIOD_NS), sc_core::SC_NS);
+    SIM_TIME = sc_core::sc_time(double(SIM_TIME_NS), sc_core::SC_NS);
+    tlm_utils::tlm_quantumkeeper::set_global_quantum(sc_core::sc_time(double(QUANTUM_NS), sc_core::SC_NS));
+    LINK_LATENCY = sc_core::sc_time(double(LINK_LATENCY_NS), sc_core::SC_NS);
+}
+
+/* All the clusters in one kernel, linked with the same latency */
+static int run_sequential()
+{
+    scp::LoggingGuard logging_guard(scp::LogConfig().logLevel(scp::log::WARNING));
+    gs::ConfigurableBroker broker;
+    configure(0, NUM_CLUSTERS - 1);
+    Container platform("platform");
+    std::vector<std::unique_ptr<gs::parallel_clusters_mailbox>> mailboxes;
+    for (int i = 0; i < NUM_CLUSTERS; i++) {
+        test_cluster* c = find_cluster(i);
+        if (!c) return 1;
+        mailboxes.push_back(
+            std::make_unique<gs::parallel_clusters_mailbox>(("mailbox_" + std::to_string(i)).c_str()));
+        mailboxes.back()->register_receive_cb([c](int from, uint64_t data) { c->receive(from, data); });
+    }
+    for (int i = 0; i < NUM_CLUSTERS; i++) {
+        find_cluster(i)->send = [&mailboxes, i](int to, uint64_t data) {
+            mailboxes[to]->push(sc_core::sc_time_stamp() + LINK_LATENCY, i, data);
+        };
+    }
+    sc_core::sc_start(SIM_TIME);
+    for (int i = 0; i < NUM_CLUSTERS; i++) {
+        g_results[i] = find_cluster(i)->result;
+        g_results[i].late = mailboxes[i]->get_late();
+    }
+    return 0;
+}
+
+/* One kernel per cluster, each process only configures and builds its own */
+static int run_parallel()
+{
+    /* Before the logger and the broker, the process has no thread and no SystemC object yet */
+    gs::parallel_clusters<> clusters(NUM_CLUSTERS, "parallel_clusters_test");
+    scp::LoggingGuard logging_guard(scp::LogConfig().logLevel(scp::log::WARNING));
+    gs::ConfigurableBroker broker;
+    configure(clusters.index(), clusters.index());
+    Container platform("platform");
+    test_cluster* c = find_cluster(clusters.index());
+    if (!c || find_cluster((clusters.index() + 1) % NUM_CLUSTERS)) return 1;
+
+    clusters.set_link_latency(LINK_LATENCY);
+    clusters.register_receive_cb([c](int from, uint64_t data) { c->receive(from, data); });
+    c->send = [&clusters](int to, uint64_t data) { clusters.send(to, data); };
+    clusters.run(SIM_TIME);
+
+    g_results[clusters.index()] = c->result;
+    g_results[clusters.index()].late = clusters.get_late();
+    return clusters.wait();
+}
+
+/*
+ * SystemC can only be elaborated once per process, run each configuration in
+ * a child. The test process itself creates no SystemC object.
+ */
+static double time_child(int (*fn)(), std::vector<cluster_result>& results)
+{
+    size_t size = sizeof(cluster_result) * NUM_CLUSTERS;
+    void* area = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    EXPECT_NE(area, MAP_FAILED);
+    g_results = static_cast<cluster_result*>(area);
+
+    auto start = std::chrono::steady_clock::now();
+    std::fflush(nullptr);
+    pid_t pid = fork();
+    if (pid == 0) {
+        int ret = fn();
+        std::fflush(nullptr);
+        _exit(ret);
+    }
+    EXPECT_GT(pid, 0);
+    int status = 0;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    results.assign(g_results, g_results + NUM_CLUSTERS);
+    munmap(area, size);
+    return elapsed;
+}
+
+TEST(parallel_clusters, benchmark)
+{
+    std::vector<cluster_result> seq, par;
+    double sequential = time_child(run_sequential, seq);
+    double parallel = time_child(run_parallel, par);
+
+    uint64_t ticks = SIM_TIME_NS / TIMER_PERIOD_NS;
+    uint64_t sent = 0;
+    for (uint64_t t = 0; t < ticks; t += SEND_EVERY) {
+        if (TIMER_PERIOD_NS * t + LINK_LATENCY_NS < SIM_TIME_NS) sent++;
+    }
+
+    for (int i = 0; i < NUM_CLUSTERS; i++) {
+        SCOPED_TRACE("cluster " + std::to_string(i));
+        EXPECT_EQ(seq[i].ticks, ticks);
+        EXPECT_GE(seq[i].bytes + 1, ticks);
+        EXPECT_EQ(seq[i].received, sent);
+        EXPECT_EQ(seq[i].misplaced, 0u);
+        EXPECT_EQ(seq[i].late, 0u);
+
+        /* the parallel kernels must reproduce the single kernel run exactly */
+        EXPECT_EQ(par[i].ticks, seq[i].ticks);
+        EXPECT_EQ(par[i].bytes, seq[i].bytes);
+        EXPECT_EQ(par[i].received, seq[i].received);
+        EXPECT_EQ(par[i].misplaced, 0u);
+        EXPECT_EQ(par[i].checksum, seq[i].checksum);
+        EXPECT_EQ(par[i].late, 0u);
+    }
+
+    std::cout << NUM_CLUSTERS << " timer/uart clusters, " << SIM_TIME_NS << "ns simulated, " << sent
+              << " messages per link" << std::endl;
+    std::cout << "single kernel: " << sequential << "s" << std::endl;
+    std::cout << "one kernel per cluster: " << parallel << "s" << std::endl;
+    std::cout << "speedup: " << (sequential / parallel) << "x" << std::endl;
+}
+
+int sc_main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <systemc>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <scp/report.h>
+#include <cciutils.h>
+#include <sync_window_shm.h>
+
+using policy = sc_core::sc_sync_policy_tlm_quantum;
+using sync_window = sc_core::sc_sync_window<policy>;
+using window = sync_window::window;
+using shm_group = sc_core::sc_sync_window_shm_group<policy>;
+
+static constexpr int NUM_PARTICIPANTS = 4;
+static constexpr int NUM_QUANTA = 2000;
+static sc_core::sc_time quantum;
+static std::string g_shm_name;
+static std::vector<pid_t> g_children;
+
+static window w(int from, int to)
+{
+    return { sc_core::sc_time(from, sc_core::SC_NS), sc_core::sc_time(to, sc_core::SC_NS) };
+}
+
+TEST(sync_window_group, horizon)
+{
+    sc_core::sc_sync_window_horizon<window> h(3);
+
+    h.set(0, w(10, 20));
+    h.set(1, w(30, 40));
+    EXPECT_FALSE(h.complete());
+    h.set(2, w(50, 60));
+    ASSERT_TRUE(h.complete());
+
+    /* everybody is bounded by the others, not by itself */
+    EXPECT_EQ(h.horizon(0), w(30, 40));
+    EXPECT_EQ(h.horizon(1), w(10, 20));
+    EXPECT_EQ(h.horizon(2), w(10, 20));
+
+    EXPECT_FALSE(h.set(1, w(30, 40)));
+    EXPECT_TRUE(h.set(0, w(70, 80)));
+    EXPECT_EQ(h.horizon(0), w(30, 40));
+    EXPECT_EQ(h.horizon(2), w(30, 40));
+
+    /* participant 2 now starts 10ns behind participant 0 */
+    h.set(2, w(60, 70));
+    EXPECT_EQ(h.stats(2).max_lag, sc_core::sc_time(10, sc_core::SC_NS));
+    EXPECT_EQ(h.stats(0).max_lag, sc_core::SC_ZERO_TIME);
+
+    /* a detached participant no longer bounds anybody */
+    h.set(1, sync_window::open_window);
+    EXPECT_EQ(h.horizon(0).to, sc_core::sc_time(70, sc_core::SC_NS));
+    EXPECT_EQ(h.horizon(2).to, sc_core::sc_time(80, sc_core::SC_NS));
+
+    /* 0, then 1, then 2 bounded the others, once each */
+    EXPECT_EQ(h.stats(0).limiting, 1u);
+    EXPECT_EQ(h.stats(1).limiting, 1u);
+    EXPECT_EQ(h.stats(2).limiting, 1u);
+}
+
+/* Steps one quantum at a time, spinning in proportion to its index to create some lag */
+class stepper : public sc_core::sc_module
+{
+    sync_window& m_window;
+    shm_group& m_group;
+    int m_index;
+
+public:
+    int violations = 0;
+
+    SC_HAS_PROCESS(stepper);
+    stepper(const sc_core::sc_module_name& n, sync_window& window, shm_group& group, int index)
+        : sc_core::sc_module(n), m_window(window), m_group(group), m_index(index)
+    {
+        SC_THREAD(run);
+    }
+
+    void run()
+    {
+        for (int i = 0; i < NUM_QUANTA; i++) {
+            auto spin = std::chrono::steady_clock::now() + std::chrono::microseconds(m_index);
+            while (std::chrono::steady_clock::now() < spin) {
+            }
+            sc_core::wait(quantum);
+            if (sc_core::sc_time_stamp() > m_group.get_horizon().to) {
+                violations++;
+            }
+        }
+        /* let the others run to their end */
+        m_window.detach();
+        sc_core::sc_stop();
+    }
+};
+
+/* Run one participant, returns the number of window violations */
+static int run_participant(int index)
+{
+    tlm_utils::tlm_quantumkeeper::set_global_quantum(quantum);
+
+    sync_window window("window");
+    shm_group group(window, g_shm_name, index, NUM_PARTICIPANTS);
+    stepper s("stepper", window, group, index);
+
+    auto start = std::chrono::steady_clock::now();
+    sc_core::sc_start();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("participant %d: %d quanta, %.0f quanta/s, %.2f us/quantum\n", index, NUM_QUANTA,
+                NUM_QUANTA / elapsed, elapsed * 1e6 / NUM_QUANTA);
+    if (index == 0) {
+        for (int i = 0; i < NUM_PARTICIPANTS; i++) {
+            auto st = group.get_stats(i);
+            std::printf("  participant %d: %llu updates, limiting %llu times, lag avg %s max %s\n", i,
+                        (unsigned long long)st.updates, (unsigned long long)st.limiting,
+                        st.avg_lag().to_string().c_str(), st.max_lag.to_string().c_str());
+        }
+    }
+    std::fflush(stdout);
+    return s.violations;
+}
+
+TEST(sync_window_group, processes)
+{
+    ASSERT_EQ(g_children.size(), size_t(NUM_PARTICIPANTS - 1));
+
+    EXPECT_EQ(run_participant(0), 0);
+
+    for (pid_t child : g_children) {
+        int status = 0;
+        ASSERT_EQ(waitpid(child, &status, 0), child);
+        ASSERT_TRUE(WIFEXITED(status));
+        EXPECT_EQ(WEXITSTATUS(status), 0);
+    }
+}
+
+int sc_main(int argc, char** argv)
+{
+    g_shm_name = "/qbox_sync_window_group_test_" + std::to_string(getpid());
+    quantum = sc_core::sc_time(1, sc_core::SC_US);
+
+    /* Fork before anything is elaborated, each process builds its own platform */
+    std::fflush(stdout);
+    int index = 0;
+    for (int i = 1; i < NUM_PARTICIPANTS; i++) {
+        pid_t pid = fork();
+        if (pid == -1) {
+            std::perror("fork");
+            return 1;
+        }
+        if (pid == 0) {
+            index = i;
+            g_children.clear();
+            break;
+        }
+        g_children.push_back(pid);
+    }
+
+    scp::LoggingGuard logging_guard(scp::LogConfig().logLevel(scp::log::WARNING));
+    gs::ConfigurableBroker broker;
+
+    if (index != 0) {
+        return run_participant(index) == 0 ? 0 : 1;
+    }
+
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <systemc>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <scp/report.h>
+#include <cciutils.h>
+#include <sync_window_shm.h>
+
+using policy = sc_core::sc_sync_policy_tlm_quantum;
+using sync_window = sc_core::sc_sync_window<policy>;
+using shm_peer = sc_core::sc_sync_window_shm_peer<policy>;
+
+static constexpr int NUM_QUANTA = 2000;
+static sc_core::sc_time quantum;
+static std::string g_shm_name;
+static pid_t g_child = -1;
+
+/* Steps one quantum at a time, checking it never runs ahead of the other process */
+class stepper : public sc_core::sc_module
+{
+    sync_window& m_window;
+    shm_peer& m_peer;
+
+public:
+    int violations = 0;
+
+    SC_HAS_PROCESS(stepper);
+    stepper(const sc_core::sc_module_name& n, sync_window& window, shm_peer& peer)
+        : sc_core::sc_module(n), m_window(window), m_peer(peer)
+    {
+        SC_THREAD(run);
+    }
+
+    void run()
+    {
+        for (int i = 0; i < NUM_QUANTA; i++) {
+            sc_core::wait(quantum);
+            if (sc_core::sc_time_stamp() > m_peer.remote_window().to) {
+                violations++;
+            }
+        }
+        /* let the other side run to its end */
+        m_window.detach();
+        sc_core::sc_stop();
+    }
+};
+
+/* Run one side of the platform, returns the number of window violations */
+static int run_side(bool create)
+{
+    tlm_utils::tlm_quantumkeeper::set_global_quantum(quantum);
+
+    sync_window window("window");
+    shm_peer peer(window, g_shm_name, create);
+    stepper s("stepper", window, peer);
+
+    auto start = std::chrono::steady_clock::now();
+    sc_core::sc_start();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%s: %d quanta in %.3fs, %.0f quanta/s, %.2f us/quantum, %llu windows sent, %llu received\n",
+                create ? "creator" : "joiner", NUM_QUANTA, elapsed, NUM_QUANTA / elapsed, elapsed * 1e6 / NUM_QUANTA,
+                (unsigned long long)peer.get_sent(), (unsigned long long)peer.get_received());
+    std::fflush(stdout);
+    return s.violations;
+}
+
+TEST(sync_window_shm, two_processes)
+{
+    ASSERT_GT(g_child, 0);
+
+    EXPECT_EQ(run_side(true), 0);
+
+    int status = 0;
+    ASSERT_EQ(waitpid(g_child, &status, 0), g_child);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+int sc_main(int argc, char** argv)
+{
+    g_shm_name = "/qbox_sync_window_test_" + std::to_string(getpid());
+    quantum = sc_core::sc_time(1, sc_core::SC_US);
+
+    /* Fork before anything is elaborated, each process builds its own platform */
+    std::fflush(stdout);
+    g_child = fork();
+    if (g_child == -1) {
+        std::perror("fork");
+        return 1;
+    }
+
+    scp::LoggingGuard logging_guard(scp::LogConfig().logLevel(scp::log::WARNING));
+    gs::ConfigurableBroker broker;
+
+    if (g_child == 0) {
+        return run_side(false) == 0 ? 0 : 1;
+    }
+
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}